@@ -1,5 +1,9 @@
+#define _GNU_SOURCE
+
 #include <stdio.h>
 #include <stdlib.h>
+#include <stdarg.h>
+#include <stdint.h>
 #include <string.h>
 #include <unistd.h>
 
@@ -9,30 +13,137 @@
 #include <errno.h>
 #include <time.h>
 #include <termios.h>
+#include <limits.h>
+#include <signal.h>
+#include <spawn.h>
+
+#include <libgen.h>
+#include <dirent.h>
+#include <fnmatch.h>
 
 #include <sys/wait.h>
-#include <sys/select.h>
+#include <sys/epoll.h>
+#include <sys/inotify.h>
+#include <sys/signalfd.h>
+#include <sys/timerfd.h>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/un.h>
+#include <sys/mman.h>
 
 #include <linux/input.h>
+#include <linux/uinput.h>
 
 #include "input-event-daemon.h"
 #include "input-event-table.h"
 
 
 static int key_event_compare(const key_event_t *a, const key_event_t *b) {
-    int i, r_cmp;
+    int i;
 
-    if((r_cmp = strcmp(a->code, b->code)) != 0) {
-        return r_cmp;
+    if(a->code != b->code) {
+        return (a->code - b->code);
+    } else if(a->modifier_mask != b->modifier_mask) {
+        return (a->modifier_mask - b->modifier_mask);
     } else if(a->modifier_n != b->modifier_n) {
         return (a->modifier_n - b->modifier_n);
+    } else if(a->gesture != b->gesture) {
+        return (a->gesture - b->gesture);
     } else {
         for(i=0; i < a->modifier_n; i++) {
-            if((r_cmp = strcmp(a->modifiers[i], b->modifiers[i])) != 0) {
-                return r_cmp;
+            if(a->modifiers[i] != b->modifiers[i]) {
+                return (a->modifiers[i] - b->modifiers[i]);
+            }
+        }
+    }
+    return 0;
+}
+
+static unsigned int
+key_event_hash(const key_event_t *key_event, unsigned int scope) {
+    unsigned int i, hash = 2166136261u;
+
+    hash = (hash ^ scope) * 16777619u;
+    hash = (hash ^ key_event->code) * 16777619u;
+    hash = (hash ^ key_event->modifier_mask) * 16777619u;
+    hash = (hash ^ key_event->gesture) * 16777619u;
+    for(i=0; i < key_event->modifier_n; i++) {
+        hash = (hash ^ key_event->modifiers[i]) * 16777619u;
+    }
+
+    return hash;
+}
+
+static key_event_t *key_event_lookup(const key_event_t *key_event) {
+    unsigned int i, index, scope = key_event->scope;
+    size_t mask = bindings->key_event_table_size - 1;
+    key_event_t *entry;
+
+    /* the bindings of the device first, then those for all devices */
+    while(1) {
+        i = key_event_hash(key_event, scope);
+
+        /* linear probing, the table is kept at most half full */
+        while((index = bindings->key_event_table[i & mask]) != 0) {
+            entry = &bindings->key_events[index-1];
+            if(
+                entry->scope == scope &&
+                key_event_compare(entry, key_event) == 0
+            ) {
+                return entry;
             }
+            i++;
+        }
+
+        if(scope == 0) {
+            return NULL;
+        }
+        scope = 0;
+    }
+}
+
+static int key_event_insert(bindings_t *new, size_t index) {
+    unsigned int i, *table;
+    size_t n, size, mask;
+
+    /* grow the table so it stays at most half full */
+    if(2 * (new->key_event_n + 1) > new->key_event_table_size) {
+        size = new->key_event_table_size * 2;
+        table = calloc(size, sizeof(unsigned int));
+        if(table == NULL) {
+            perror(PROGRAM": calloc()");
+            exit(EXIT_FAILURE);
+        }
+
+        for(n=0; n < new->key_event_n; n++) {
+            i = key_event_hash(&new->key_events[n], new->key_events[n].scope);
+            while(table[i & (size-1)] != 0) i++;
+            table[i & (size-1)] = n+1;
+        }
+
+        free(new->key_event_table);
+        new->key_event_table = table;
+        new->key_event_table_size = size;
+    }
+
+    table = new->key_event_table;
+    mask = new->key_event_table_size - 1;
+    i = key_event_hash(&new->key_events[index], new->key_events[index].scope);
+
+    while(table[i & mask] != 0) {
+        if(
+            new->key_events[table[i & mask]-1].scope ==
+                new->key_events[index].scope &&
+            key_event_compare(
+                &new->key_events[table[i & mask]-1], &new->key_events[index]
+            ) == 0
+        ) {
+            return -1;
         }
+        i++;
     }
+    table[i & mask] = index+1;
+
     return 0;
 }
 
@@ -44,769 +155,4978 @@ static const char *key_event_name(unsigned int code) {
     }
 }
 
-static const char *key_event_modifier_name(const char* code) {
-    if(
-        strcmp(code, "LEFTCTRL") == 0 || strcmp(code, "RIGHTCTRL") == 0
-    ) {
-        return "CTRL";
-    } else if(
-        strcmp(code, "LEFTALT") == 0 || strcmp(code, "RIGHTALT") == 0
-    ) {
-        return "ALT";
-    } else if(
-        strcmp(code, "LEFTSHIFT") == 0 || strcmp(code, "RIGHTSHIFT") == 0
-    ) {
-        return "SHIFT";
-    } else if(
-        strcmp(code, "LEFTMETA") == 0 || strcmp(code, "RIGHTMETA") == 0
-    ) {
-        return "META";
+static int key_event_code(const char *name) {
+    const event_code_t *entry;
+
+    entry = bsearch(name, KEY_CODE, sizeof(KEY_CODE) / sizeof(KEY_CODE[0]),
+        sizeof(event_code_t), config_code_compare);
+
+    return (entry != NULL) ? entry->code : -1;
+}
+
+static unsigned int key_event_modifier(unsigned int code) {
+    switch(code) {
+        case KEY_LEFTCTRL:  case KEY_RIGHTCTRL:  return MODIFIER_CTRL;
+        case KEY_LEFTALT:   case KEY_RIGHTALT:   return MODIFIER_ALT;
+        case KEY_LEFTSHIFT: case KEY_RIGHTSHIFT: return MODIFIER_SHIFT;
+        case KEY_LEFTMETA:  case KEY_RIGHTMETA:  return MODIFIER_META;
+    }
+
+    return 0;
+}
+
+static int key_event_modifier_down(const key_state_t *state, unsigned int modifier) {
+    switch(modifier) {
+        case MODIFIER_CTRL:
+            return test_bit(state->down, KEY_LEFTCTRL) ||
+                   test_bit(state->down, KEY_RIGHTCTRL);
+        case MODIFIER_ALT:
+            return test_bit(state->down, KEY_LEFTALT) ||
+                   test_bit(state->down, KEY_RIGHTALT);
+        case MODIFIER_SHIFT:
+            return test_bit(state->down, KEY_LEFTSHIFT) ||
+                   test_bit(state->down, KEY_RIGHTSHIFT);
+        case MODIFIER_META:
+            return test_bit(state->down, KEY_LEFTMETA) ||
+                   test_bit(state->down, KEY_RIGHTMETA);
+    }
+
+    return 0;
+}
+
+static size_t
+key_event_format(char *buffer, size_t size, const key_event_t *key_event) {
+    size_t len = 0;
+    int i;
+
+    #define append(...) \
+        len += snprintf(buffer + len, len < size ? size - len : 0, __VA_ARGS__)
+
+    if(key_event->modifier_mask & MODIFIER_CTRL)  append("CTRL + ");
+    if(key_event->modifier_mask & MODIFIER_ALT)   append("ALT + ");
+    if(key_event->modifier_mask & MODIFIER_SHIFT) append("SHIFT + ");
+    if(key_event->modifier_mask & MODIFIER_META)  append("META + ");
+
+    for(i=0; i < key_event->modifier_n; i++) {
+        append("%s + ", key_event_name(key_event->modifiers[i]));
+    }
+
+    append("%s", key_event_name(key_event->code));
+
+    if(key_event->gesture != GESTURE_PRESS) {
+        append(" (%s)", GESTURE_NAME[key_event->gesture]);
     }
 
-    return code;
+    #undef append
+
+    return len;
 }
 
 static key_event_t
-*key_event_parse(unsigned int code, int pressed, const char *src) {
+*key_event_parse(unsigned int code, int pressed, key_state_t *state,
+    const char *src) {
     key_event_t *fired_key_event = NULL;
-    static key_event_t current_key_event = {
-        .code = NULL,
-        .modifier_n = 0
-    };
+    key_event_t *current = &state->current;
+    unsigned int modifier;
+    int i;
+
+    if(code >= KEY_CNT) {
+        return NULL;
+    }
 
     if(pressed) {
 
         /* ignore if repeated */
-        if(
-            current_key_event.code != NULL &&
-            strcmp(current_key_event.code, key_event_name(code)) == 0
-        ) {
+        if(test_bit(state->down, code)) {
             return NULL;
         }
+        set_bit(state->down, code);
 
         /* if previous key present and modifier limit not yet reached */
         if(
-            current_key_event.code != NULL &&
-            current_key_event.modifier_n < MAX_MODIFIERS
+            current->code != KEY_RESERVED &&
+            __builtin_popcount(current->modifier_mask) +
+                current->modifier_n < MAX_MODIFIERS
         ) {
-            int i;
-
-            /* if not already in the modifiers array */
-            for(i=0; i < current_key_event.modifier_n; i++) {
-                if(strcmp(
-                        current_key_event.modifiers[i], current_key_event.code
-                    ) == 0
+            /* add previous key as modifier */
+            if((modifier = key_event_modifier(current->code))) {
+                current->modifier_mask |= modifier;
+            } else {
+                /* keep the modifiers sorted, as in the bindings */
+                for(i=current->modifier_n; i > 0 &&
+                    current->modifiers[i-1] > current->code; i--
                 ) {
-                    return NULL;
+                    current->modifiers[i] = current->modifiers[i-1];
                 }
+                current->modifiers[i] = current->code;
+                current->modifier_n++;
             }
-
-            /* add previous key as modifier */
-            current_key_event.modifiers[current_key_event.modifier_n++] =
-                key_event_modifier_name(current_key_event.code);
-
         }
 
-        current_key_event.code = key_event_name(code);
+        current->code = code;
 
-        if(current_key_event.modifier_n == 0) {
-            if(conf.monitor) {
-                printf("%s:\n  keys      : ", src);
-                printf("%s\n\n", current_key_event.code);
+        if(current->modifier_mask == 0 && current->modifier_n == 0) {
+            if(conf.monitor == MONITOR_TEXT) {
+                monitor_printf("%s:\n  keys      : %s\n\n",
+                    src, key_event_name(code));
             }
 
-            fired_key_event = bsearch(
-                &current_key_event,
-                key_events,
-                key_event_n,
-                sizeof(key_event_t),
-                (int (*)(const void *, const void *)) key_event_compare
-            );
+            /* a modifier alone is no step, it only starts the next chord */
+            if(
+                bindings->sequence_event_n == 0 || key_event_modifier(code) ||
+                !sequence_event_advance(state, src)
+            ) {
+                fired_key_event = key_event_lookup(current);
+            }
         }
 
-
     } else {
-        int i, new_modifier_n = 0;
-        const char *new_modifiers[MAX_MODIFIERS], *modifier_code;
 
-        if(current_key_event.code != NULL && current_key_event.modifier_n > 0) {
+        /* ignore keys which were pressed before we started listening */
+        if(!test_bit(state->down, code)) {
+            return NULL;
+        }
+        clear_bit(state->down, code);
 
-            if(conf.monitor) {
-                printf("%s:\n  keys     : ", src);
-                for(i=0; i < current_key_event.modifier_n; i++) {
-                     printf("%s + ", current_key_event.modifiers[i]);
-                }
-                printf("%s\n\n", current_key_event.code);
-            }
+        if(
+            current->code != KEY_RESERVED &&
+            (current->modifier_mask != 0 || current->modifier_n > 0)
+        ) {
 
-            qsort(
-                current_key_event.modifiers,
-                current_key_event.modifier_n,
-                sizeof(const char*),
-                (int (*)(const void *, const void *)) strcmp
-            );
+            if(conf.monitor == MONITOR_TEXT) {
+                char keys[MONITOR_LINE];
 
-            fired_key_event = bsearch(
-                &current_key_event,
-                key_events,
-                key_event_n,
-                sizeof(key_event_t),
-                (int (*)(const void *, const void *)) key_event_compare
-            );
+                key_event_format(keys, sizeof(keys), current);
+                monitor_printf("%s:\n  keys     : %s\n\n", src, keys);
+            }
 
+            /* a chord continuing a started sequence is taken by it */
+            if(
+                bindings->sequence_event_n == 0 ||
+                !sequence_event_advance(state, src)
+            ) {
+                fired_key_event = key_event_lookup(current);
+            }
         }
 
-        if(
-            current_key_event.code != NULL &&
-            strcmp(current_key_event.code, key_event_name(code)) == 0
-        ) {
-            current_key_event.code = NULL;
+        if(current->code == code) {
+            current->code = KEY_RESERVED;
         }
 
         /* remove released key from modifiers */
-        modifier_code = key_event_modifier_name(key_event_name(code));
-        for(i=0; i < current_key_event.modifier_n; i++) {
-            if(strcmp(current_key_event.modifiers[i], modifier_code) != 0) {
-                new_modifiers[new_modifier_n++] =
-                    current_key_event.modifiers[i];
+        if((modifier = key_event_modifier(code))) {
+            if(!key_event_modifier_down(state, modifier)) {
+                current->modifier_mask &= ~modifier;
+            }
+        } else {
+            for(i=0; i < current->modifier_n; i++) {
+                if(current->modifiers[i] == code) {
+                    current->modifier_n--;
+                    for(; i < current->modifier_n; i++) {
+                        current->modifiers[i] = current->modifiers[i+1];
+                    }
+                    break;
+                }
             }
         }
-        memcpy(current_key_event.modifiers, new_modifiers,
-            MAX_MODIFIERS*sizeof(const char*));
-        current_key_event.modifier_n = new_modifier_n;
 
     }
 
     if(conf.verbose && fired_key_event) {
-        int i;
+        key_event_report(fired_key_event, src, "key_event");
+    }
 
-        fprintf(stderr, "\nkey_event:\n"
-                        "  code     : ");
-        for(i=0; i < fired_key_event->modifier_n; i++) {
-            fprintf(stderr, "%s + ", fired_key_event->modifiers[i]);
-        }
+    return fired_key_event;
+}
 
-        fprintf(stderr, "%s\n"
-                        "  source   : %s\n"
-                        "  exec     : \"%s\"\n\n",
-                        fired_key_event->code,
-                        src,
-                        fired_key_event->exec
-        );
+static key_event_t
+*key_event_repeat(unsigned int code, key_state_t *state, const char *src) {
+    key_event_t *fired_key_event;
+    limit_t *limit;
+    unsigned long long now;
+
+    /* only the last key pressed repeats */
+    if(code != state->current.code) {
+        return NULL;
+    }
+
+    fired_key_event = key_event_lookup(&state->current);
+    if(
+        fired_key_event == NULL ||
+        (limit = fired_key_event->exec.limit) == NULL || !limit->repeat
+    ) {
+        return NULL;
+    }
+
+    now = conf.event_us ? conf.event_us : daemon_monotonic_us();
+    if(limit->repeat_last_us > 0 && now < limit->repeat_last_us + limit->repeat_us) {
+        return NULL;
+    }
+    limit->repeat_last_us = now;
+
+    if(conf.verbose) {
+        key_event_report(fired_key_event, src, "key_event (repeat)");
     }
 
     return fired_key_event;
 }
 
-static int idle_event_compare(const idle_event_t *a, const idle_event_t *b) {
-    return (a->timeout - b->timeout);
+static void
+key_event_report(const key_event_t *key_event, const char *src,
+    const char *kind) {
+    char keys[MONITOR_LINE];
+
+    key_event_format(keys, sizeof(keys), key_event);
+    fprintf(stderr, "\n%s:\n"
+                    "  code     : %s\n"
+                    "  source   : %s\n"
+                    "  exec     : \"%s\"\n\n",
+                    kind,
+                    keys,
+                    src,
+                    key_event->exec.line
+    );
 }
 
-static int idle_event_parse(unsigned long idle) {
-    idle_event_t *fired_idle_event;
-    idle_event_t current_idle_event = {
-        .timeout = idle
-    };
+static key_event_t
+*gesture_event_lookup(unsigned int code, unsigned int gesture,
+    unsigned int scope) {
+    key_event_t key_event;
 
-    fired_idle_event = bsearch(
-        &current_idle_event,
-        idle_events,
-        idle_event_n,
-        sizeof(idle_event_t),
-        (int (*)(const void *, const void *)) idle_event_compare
-    );
+    memset(&key_event, 0, sizeof(key_event));
+    key_event.code = code;
+    key_event.gesture = gesture;
+    key_event.scope = scope;
 
-    if(fired_idle_event != NULL) {
-        if(conf.verbose) {
-            fprintf(stderr, "\nidle_event:\n");
+    return key_event_lookup(&key_event);
+}
 
-            if(fired_idle_event->timeout == IDLE_RESET) {
-                fprintf(stderr, "  time     : idle reset\n");
-            } else {
-                fprintf(stderr, "  time     : %ldh %ldm %lds\n",
-                                fired_idle_event->timeout / 3600,
-                                fired_idle_event->timeout % 3600 / 60,
-                                fired_idle_event->timeout % 60
-                );
+static void
+gesture_event_key(unsigned int code, int pressed, key_state_t *state,
+    const char *src) {
+    key_event_t *gesture_event;
+    unsigned long long now;
+
+    now = conf.event_us ? conf.event_us : daemon_monotonic_us();
+
+    /* the timer may not have been read yet */
+    if(state->gesture_deadline > 0 && now >= state->gesture_deadline) {
+        gesture_event_timeout(state, src);
+    }
+
+    if(pressed) {
+        if(state->gesture_phase == GESTURE_UP) {
+            state->gesture_deadline = 0;
+
+            if(state->gesture_code == code) {
+                state->gesture_phase = GESTURE_DONE;
+                gesture_event_fire(state, code, GESTURE_DOUBLE, src);
+                return;
             }
 
-            fprintf(stderr, "  exec     : \"%s\"\n\n", fired_idle_event->exec);
+            /* another key, the first one was a single tap */
+            gesture_event_fire(state, state->gesture_code, GESTURE_RELEASE,
+                src);
         }
-        daemon_exec(fired_idle_event->exec);
-    }
 
-    return (fired_idle_event != NULL);
-}
+        /* any further key turns a gesture into a chord */
+        state->gesture_phase = GESTURE_IDLE;
+        state->gesture_deadline = 0;
 
-static int
-switch_event_compare(const switch_event_t *a, const switch_event_t *b) {
-    int r_cmp;
+        if(
+            code >= KEY_CNT || !test_bit(bindings->gesture_keys, code) ||
+            state->current.modifier_mask != 0 || state->current.modifier_n > 0
+        ) {
+            return;
+        }
+
+        state->gesture_code = code;
+        state->gesture_phase = GESTURE_DOWN;
+
+        /* the kernel timestamp of the press, not the time it was read */
+        if((gesture_event = gesture_event_lookup(code, GESTURE_HOLD,
+            state->current.scope))) {
+            state->gesture_deadline = now + gesture_event->exec.limit->gesture_us;
+            daemon_timer_arm(state->gesture_deadline);
+        }
+
+    } else if(state->gesture_code == code) {
+
+        if(state->gesture_phase != GESTURE_DOWN) {
+            if(state->gesture_phase == GESTURE_DONE) {
+                state->gesture_phase = GESTURE_IDLE;
+            }
+            return;
+        }
+        state->gesture_deadline = 0;
+
+        /* a tap, unless a second one follows in time */
+        if((gesture_event = gesture_event_lookup(code, GESTURE_DOUBLE,
+            state->current.scope))) {
+            state->gesture_phase = GESTURE_UP;
+            state->gesture_deadline = now + gesture_event->exec.limit->gesture_us;
+            daemon_timer_arm(state->gesture_deadline);
+        } else {
+            state->gesture_phase = GESTURE_IDLE;
+            gesture_event_fire(state, code, GESTURE_RELEASE, src);
+        }
 
-    if((r_cmp = strcmp(a->code, b->code)) != 0) {
-        return r_cmp;
-    } else {
-        return (a->value - b->value);
     }
 }
 
-static const char *switch_event_name(unsigned int code) {
-    if(code < SW_MAX && SW_NAME[code] != NULL) {
-        return SW_NAME[code];
-    } else {
-        return "UNKNOWN";
+static void
+gesture_event_fire(const key_state_t *state, unsigned int code,
+    unsigned int gesture, const char *src) {
+    key_event_t *gesture_event;
+
+    gesture_event = gesture_event_lookup(code, gesture, state->current.scope);
+    if(gesture_event == NULL) {
+        return;
     }
+
+    if(conf.verbose) {
+        key_event_report(gesture_event, src, "key_event");
+    }
+
+    conf.key_matched++;
+    daemon_exec(&gesture_event->exec);
 }
 
-static switch_event_t
-*switch_event_parse(unsigned int code, int value, const char *src) {
-    switch_event_t *fired_switch_event;
-    switch_event_t current_switch_event = {
-        .code = switch_event_name(code),
-        .value = value
-    };
+static void gesture_event_timeout(key_state_t *state, const char *src) {
+    state->gesture_deadline = 0;
 
-    if(conf.monitor) {
-        printf("%s:\n  switch   : %s:%d\n\n",
-            src,
-            current_switch_event.code,
-            current_switch_event.value
-        );
+    /* held long enough, or no second tap */
+    if(state->gesture_phase == GESTURE_DOWN) {
+        state->gesture_phase = GESTURE_DONE;
+        gesture_event_fire(state, state->gesture_code, GESTURE_HOLD, src);
+    } else if(state->gesture_phase == GESTURE_UP) {
+        state->gesture_phase = GESTURE_IDLE;
+        gesture_event_fire(state, state->gesture_code, GESTURE_RELEASE, src);
     }
+}
 
-    fired_switch_event = bsearch(
-        &current_switch_event,
-        switch_events,
-        switch_event_n,
-        sizeof(switch_event_t),
-        (int (*)(const void *, const void *)) switch_event_compare
-    );
+static unsigned long long gesture_event_expire(unsigned long long now) {
+    unsigned long long next = 0;
+    listener_t *listener;
+    key_state_t *state;
+    size_t i;
 
-    if(conf.verbose && fired_switch_event) {
-        fprintf(stderr, "\nswitch_event:\n"
-                        "  switch   : %s:%d\n"
-                        "  source   : %s\n"
-                        "  exec     : \"%s\"\n\n",
-                        fired_switch_event->code,
-                        fired_switch_event->value,
-                        src,
-                        fired_switch_event->exec
-        );
+    if(bindings->gesture_n == 0) {
+        return 0;
     }
 
-    return fired_switch_event;
-}
-
-void input_open_all_listener() {
-    int i, listen_len = 0;
-    char filename[32];
+    /* the global state is checked after the listeners */
+    for(i=0; i <= conf.listener_n; i++) {
+        listener = (i < conf.listener_n) ? conf.listener[i] : NULL;
+        state = listener ? &listener->keys : &conf.key_state;
 
-    for(i=0; i<MAX_LISTENER; i++) {
-        snprintf(filename, sizeof(filename), "/dev/input/event%d", i);
-        if(access(filename, R_OK) != 0) {
-            if(errno != ENOENT) {
-                fprintf(stderr, PROGRAM": access(%s): %s\n",
-                    filename, strerror(errno));
+        if(state->gesture_deadline == 0) {
+            continue;
+        } else if(state->gesture_deadline > now) {
+            if(next == 0 || state->gesture_deadline < next) {
+                next = state->gesture_deadline;
             }
             continue;
         }
-        conf.listen[listen_len++] = strdup(filename);
+
+        /* @led acts on the device that was pressed */
+        conf.source = listener;
+        gesture_event_timeout(state, listener ? listener->path : "global");
+        conf.source = NULL;
     }
-}
 
-void input_list_devices() {
-    int fd, i, e;
-    unsigned char evmask[EV_MAX/8 + 1];
+    return next;
+}
 
-    for(i=0; i < MAX_LISTENER && conf.listen[i] != NULL; i++) {
-        char phys[64] = "no physical path", name[256] = "Unknown Device";
+static unsigned int
+sequence_event_hash(unsigned int parent, const key_event_t *step) {
+    return (key_event_hash(step, 0) ^ parent) * 16777619u;
+}
 
-        fd = open(conf.listen[i], O_RDONLY);
-        if(fd < 0) {
-            fprintf(stderr, PROGRAM": open(%s): %s\n",
-                conf.listen[i], strerror(errno));
-            continue;
+static unsigned int
+sequence_event_lookup(const bindings_t *b, unsigned int parent,
+    const key_event_t *step) {
+    unsigned int i = sequence_event_hash(parent, step), node;
+    size_t mask = b->sequence_event_table_size - 1;
+    const sequence_event_t *entry;
+
+    /* one probe sequence per step, however many sequences share it */
+    while((node = b->sequence_event_table[i & mask]) != 0) {
+        entry = &b->sequence_events[node-1];
+        if(entry->parent == parent && key_event_compare(&entry->step, step) == 0) {
+            return node;
         }
+        i++;
+    }
 
-        memset(evmask, '\0', sizeof(evmask));
-
-        ioctl(fd, EVIOCGNAME(sizeof(name)), name);
-        ioctl(fd, EVIOCGPHYS(sizeof(phys)), phys);
-        ioctl(fd, EVIOCGBIT(0, sizeof(evmask)), evmask);
+    return 0;
+}
 
-        printf("%s:\n", conf.listen[i]);
-        printf("  name     : %s\n", name);
-        printf("  phys     : %s\n", phys);
+static void sequence_event_insert(bindings_t *new, unsigned int node) {
+    unsigned int i, *table;
+    size_t n, size;
+    const sequence_event_t *entry;
+
+    /* grow the table so it stays at most half full, as for the keys */
+    if(2 * new->sequence_event_n > new->sequence_event_table_size) {
+        size = new->sequence_event_table_size * 2;
+        table = calloc(size, sizeof(unsigned int));
+        if(table == NULL) {
+            perror(PROGRAM": calloc()");
+            exit(EXIT_FAILURE);
+        }
 
-        printf("  features :");
-        for(e=0; e<EV_MAX; e++) {
-            if (test_bit(evmask, e)) {
-                const char *feature = "unknown";
-                switch(e) {
-                    case EV_SYN: feature = "syn";      break;
-                    case EV_KEY: feature = "keys";     break;
-                    case EV_REL: feature = "relative"; break;
-                    case EV_ABS: feature = "absolute"; break;
-                    case EV_MSC: feature = "reserved"; break;
-                    case EV_LED: feature = "leds";     break;
-                    case EV_SND: feature = "sound";    break;
-                    case EV_REP: feature = "repeat";   break;
-                    case EV_FF:  feature = "feedback"; break;
-                    case EV_SW:  feature = "switch";   break;
-                }
-                printf(" %s", feature);
-            }
+        for(n=1; n < node; n++) {
+            entry = &new->sequence_events[n-1];
+            i = sequence_event_hash(entry->parent, &entry->step);
+            while(table[i & (size-1)] != 0) i++;
+            table[i & (size-1)] = n;
         }
-        printf("\n\n");
-        close(fd);
+
+        free(new->sequence_event_table);
+        new->sequence_event_table = table;
+        new->sequence_event_table_size = size;
     }
+
+    entry = &new->sequence_events[node-1];
+    size = new->sequence_event_table_size;
+    i = sequence_event_hash(entry->parent, &entry->step);
+    while(new->sequence_event_table[i & (size-1)] != 0) i++;
+    new->sequence_event_table[i & (size-1)] = node;
 }
 
-static void input_parse_event(struct input_event *event, const char *src) {
-    key_event_t *fired_key_event;
-    switch_event_t *fired_switch_event;
+static int sequence_event_advance(key_state_t *state, const char *src) {
+    sequence_event_t *sequence_event;
+    unsigned long long now;
+    unsigned int node = 0;
+    int taken = 0;
+    char keys[MONITOR_LINE];
 
-    switch(event->type) {
-        case EV_KEY:
-            fired_key_event = key_event_parse(event->code, event->value, src);
+    now = conf.event_us ? conf.event_us : daemon_monotonic_us();
 
-            if(fired_key_event != NULL) {
-                daemon_exec(fired_key_event->exec);
-            }
-            break;
-        case EV_SW:
-            fired_switch_event =
-                switch_event_parse(event->code, event->value, src);
+    /* the timer may not have been read yet */
+    if(state->sequence && now < state->sequence_deadline) {
+        node = sequence_event_lookup(bindings, state->sequence, &state->current);
+        taken = (node != 0);
+    }
 
-            if(fired_switch_event != NULL) {
-                daemon_exec(fired_switch_event->exec);
-            }
+    /* a wrong step starts over, maybe with the first step of another one */
+    if(node == 0) {
+        node = sequence_event_lookup(bindings, 0, &state->current);
+    }
 
-            break;
+    state->sequence = 0;
+    state->sequence_taken = taken ? state->current.code : KEY_RESERVED;
+    if(node == 0) {
+        return taken;
     }
-}
 
+    sequence_event = &bindings->sequence_events[node-1];
+    if(sequence_event->children > 0) {
+        state->sequence = node;
+        state->sequence_deadline = now + sequence_event->timeout_us;
+        daemon_timer_arm(state->sequence_deadline);
+        return taken;
+    }
 
-void config_parse_file() {
-    FILE *config_fd;
-    char buffer[512], *line;
-    char *section = NULL;
-    char *key, *value, *ptr;
+    if(conf.verbose) {
+        sequence_event_format(keys, sizeof(keys), node);
+        fprintf(stderr, "\nsequence_event:\n"
+                        "  code     : %s\n"
+                        "  source   : %s\n"
+                        "  exec     : \"%s\"\n\n",
+                        keys,
+                        src,
+                        sequence_event->step.exec.line
+        );
+    }
+
+    conf.sequence_matched++;
+    daemon_exec(&sequence_event->step.exec);
+
+    return taken;
+}
+
+static int sequence_event_step(const key_state_t *state) {
+    const key_event_t *current = &state->current;
+    unsigned long long now;
+
+    /* a single key is taken on its press already */
+    if(current->modifier_mask == 0 && current->modifier_n == 0) {
+        return state->sequence_taken == current->code;
+    }
+
+    /* a chord only on its release, see sequence_event_advance() */
+    now = conf.event_us ? conf.event_us : daemon_monotonic_us();
+    return state->sequence != 0 && now < state->sequence_deadline &&
+        sequence_event_lookup(bindings, state->sequence, current) != 0;
+}
+
+static unsigned long long sequence_event_expire(unsigned long long now) {
+    unsigned long long next = 0;
+    key_state_t *state;
+    char keys[MONITOR_LINE];
+    size_t i;
+
+    if(bindings->sequence_event_n == 0) {
+        return 0;
+    }
+
+    /* the global state is checked after the listeners */
+    for(i=0; i <= conf.listener_n; i++) {
+        state = (i < conf.listener_n) ?
+            &conf.listener[i]->keys : &conf.key_state;
+
+        if(state->sequence == 0) {
+            continue;
+        } else if(state->sequence_deadline > now) {
+            if(next == 0 || state->sequence_deadline < next) {
+                next = state->sequence_deadline;
+            }
+            continue;
+        }
+
+        if(conf.verbose) {
+            sequence_event_format(keys, sizeof(keys), state->sequence);
+            fprintf(stderr, PROGRAM": sequence %s timed out\n", keys);
+        }
+        state->sequence = 0;
+    }
+
+    return next;
+}
+
+static size_t
+sequence_event_format(char *buffer, size_t size, unsigned int node) {
+    const sequence_event_t *sequence_event = &bindings->sequence_events[node-1];
+    size_t len = 0;
+
+    if(sequence_event->parent != 0) {
+        len = sequence_event_format(buffer, size, sequence_event->parent);
+        len += snprintf(buffer + len, len < size ? size - len : 0, ", ");
+    }
+
+    return len + key_event_format(buffer + len, len < size ? size - len : 0,
+        &sequence_event->step);
+}
+
+static int idle_event_compare(const idle_event_t *a, const idle_event_t *b) {
+    return (a->timeout - b->timeout);
+}
+
+static void idle_event_exec(const idle_event_t *idle_event) {
+    if(conf.verbose) {
+        fprintf(stderr, "\nidle_event:\n");
+
+        if(idle_event->timeout == IDLE_RESET) {
+            fprintf(stderr, "  time     : idle reset\n");
+        } else {
+            fprintf(stderr, "  time     : %ldh %ldm %lds\n",
+                            idle_event->timeout / 3600,
+                            idle_event->timeout % 3600 / 60,
+                            idle_event->timeout % 60
+            );
+        }
+
+        fprintf(stderr, "  exec     : \"%s\"\n\n", idle_event->exec.line);
+    }
+    conf.idle_fired++;
+    daemon_exec(&idle_event->exec);
+}
+
+static void idle_event_schedule(unsigned long long now) {
+    unsigned long long idle = now - conf.idle_last;
+    size_t i;
+
+    /* idle events are sorted, skip the ones whose time has passed */
+    for(i=0; i < bindings->idle_event_n; i++) {
+        if(bindings->idle_events[i].timeout * 1000000ULL > idle) {
+            break;
+        }
+    }
+    conf.idle_next = i;
+}
+
+static unsigned long long idle_event_deadline() {
+    if(conf.idle_next >= bindings->idle_event_n) {
+        return 0;
+    }
+
+    return conf.idle_last +
+        bindings->idle_events[conf.idle_next].timeout * 1000000ULL;
+}
+
+static void idle_event_reset() {
+    size_t i;
+
+    /* RESET events sort first */
+    for(i=0; i < bindings->idle_event_n; i++) {
+        if(bindings->idle_events[i].timeout != IDLE_RESET) {
+            break;
+        }
+        idle_event_exec(&bindings->idle_events[i]);
+    }
+    conf.idle = 0;
+}
+
+static void idle_event_activity(unsigned long long last) {
+    if(last > conf.idle_last) {
+        conf.idle_last = last;
+    }
+
+    /* the pending timer is only moved forward once it expires */
+    idle_event_schedule(conf.idle_last);
+    daemon_timer_arm(idle_event_deadline());
+}
+
+static void idle_event_expire(unsigned long long now) {
+    idle_event_t *idle_event;
+
+    while(conf.idle_next < bindings->idle_event_n) {
+        idle_event = &bindings->idle_events[conf.idle_next];
+
+        if(conf.idle_last + idle_event->timeout * 1000000ULL > now) {
+            break;
+        }
+
+        idle_event_exec(idle_event);
+        conf.idle_next++;
+        conf.idle = 1;
+    }
+}
+
+static int
+switch_event_compare(const switch_event_t *a, const switch_event_t *b) {
+    if(a->code != b->code) {
+        return (a->code - b->code);
+    } else if(a->value != b->value) {
+        return (a->value - b->value);
+    } else {
+        return (a->scope - b->scope);
+    }
+}
+
+static const char *switch_event_name(unsigned int code) {
+    if(code < SW_MAX && SW_NAME[code] != NULL) {
+        return SW_NAME[code];
+    } else {
+        return "UNKNOWN";
+    }
+}
+
+static int switch_event_code(const char *name) {
+    const event_code_t *entry;
+
+    entry = bsearch(name, SW_CODE, sizeof(SW_CODE) / sizeof(SW_CODE[0]),
+        sizeof(event_code_t), config_code_compare);
+
+    return (entry != NULL) ? entry->code : -1;
+}
+
+static switch_event_t
+*switch_event_parse(unsigned int code, int value, unsigned int scope,
+    const char *src) {
+    switch_event_t *fired_switch_event;
+    switch_event_t current_switch_event = {
+        .code = code,
+        .value = value,
+        .scope = scope
+    };
+
+    if(conf.monitor == MONITOR_TEXT) {
+        monitor_printf("%s:\n  switch   : %s:%d\n\n",
+            src,
+            switch_event_name(code),
+            current_switch_event.value
+        );
+    }
+
+    fired_switch_event = bsearch(
+        &current_switch_event,
+        bindings->switch_events,
+        bindings->switch_event_n,
+        sizeof(switch_event_t),
+        (int (*)(const void *, const void *)) switch_event_compare
+    );
+
+    /* nothing for the device itself, try the bindings for all devices */
+    if(fired_switch_event == NULL && scope != 0) {
+        current_switch_event.scope = 0;
+        fired_switch_event = bsearch(
+            &current_switch_event,
+            bindings->switch_events,
+            bindings->switch_event_n,
+            sizeof(switch_event_t),
+            (int (*)(const void *, const void *)) switch_event_compare
+        );
+    }
+
+    if(conf.verbose && fired_switch_event) {
+        fprintf(stderr, "\nswitch_event:\n"
+                        "  switch   : %s:%d\n"
+                        "  source   : %s\n"
+                        "  exec     : \"%s\"\n\n",
+                        switch_event_name(fired_switch_event->code),
+                        fired_switch_event->value,
+                        src,
+                        fired_switch_event->exec.line
+        );
+    }
+
+    return fired_switch_event;
+}
+
+static int axis_event_compare(const axis_event_t *a, const axis_event_t *b) {
+    if(a->type != b->type) {
+        return (a->type - b->type);
+    } else if(a->code != b->code) {
+        return (a->code - b->code);
+    } else if(a->threshold != b->threshold) {
+        return (a->threshold < b->threshold) ? -1 : 1;
+    } else {
+        return (a->below - b->below);
+    }
+}
+
+static const char *axis_event_name(unsigned int type, unsigned int code) {
+    if(type == EV_REL && code < REL_CNT && REL_NAME[code] != NULL) {
+        return REL_NAME[code];
+    } else if(type == EV_ABS && code < ABS_CNT && ABS_NAME[code] != NULL) {
+        return ABS_NAME[code];
+    } else {
+        return "UNKNOWN";
+    }
+}
+
+static int axis_event_code(unsigned int type, const char *name) {
+    const event_code_t *entry;
+
+    if(type == EV_REL) {
+        entry = bsearch(name, REL_CODE, sizeof(REL_CODE) / sizeof(REL_CODE[0]),
+            sizeof(event_code_t), config_code_compare);
+    } else {
+        entry = bsearch(name, ABS_CODE, sizeof(ABS_CODE) / sizeof(ABS_CODE[0]),
+            sizeof(event_code_t), config_code_compare);
+    }
+
+    return (entry != NULL) ? entry->code : -1;
+}
+
+static void
+axis_event_update(const struct input_event *event, axis_state_t *axes) {
+    /* only collected here, bindings are looked at once per SYN_REPORT */
+    if(event->type == EV_REL) {
+        if(event->code < REL_CNT &&
+            (conf.monitor == MONITOR_TEXT ||
+                bindings->rel_mask & (1u << event->code))
+        ) {
+            axes->rel[event->code] += event->value;
+            axes->rel_changed |= 1u << event->code;
+        }
+    } else if(event->code < ABS_CNT &&
+        (conf.monitor == MONITOR_TEXT ||
+            bindings->abs_mask & (1ull << event->code))
+    ) {
+        axes->abs[event->code] = event->value;
+        axes->abs_changed |= 1ull << event->code;
+    }
+}
+
+static void axis_event_frame(axis_state_t *axes, const char *src) {
+    unsigned int code;
+
+    while(axes->rel_changed) {
+        code = __builtin_ctz(axes->rel_changed);
+        axes->rel_changed &= axes->rel_changed - 1;
+
+        axis_event_dispatch(axes, EV_REL, code, axes->rel[code], src);
+        axes->rel[code] = 0;
+    }
+
+    while(axes->abs_changed) {
+        code = __builtin_ctzll(axes->abs_changed);
+        axes->abs_changed &= axes->abs_changed - 1;
+
+        axis_event_dispatch(axes, EV_ABS, code, axes->abs[code], src);
+    }
+}
+
+static void
+axis_event_dispatch(axis_state_t *axes, unsigned int type, unsigned int code,
+    int value, const char *src) {
+    const axis_event_t *axis_event, *fired_axis_event = NULL;
+    size_t low = 0, high = bindings->axis_event_n, mid;
+    int hysteresis, crossed, released;
+
+    if(conf.monitor == MONITOR_TEXT) {
+        if(type == EV_REL) {
+            monitor_printf("%s:\n  relative : %s:%+d\n\n",
+                src, axis_event_name(type, code), value);
+        } else {
+            monitor_printf("%s:\n  absolute : %s:%d\n\n",
+                src, axis_event_name(type, code), value);
+        }
+    }
+
+    /* first binding of the axis, they are sorted by threshold */
+    while(low < high) {
+        mid = (low + high) / 2;
+        axis_event = &bindings->axis_events[mid];
+
+        if(axis_event->type < type ||
+            (axis_event->type == type && axis_event->code < code)
+        ) {
+            low = mid + 1;
+        } else {
+            high = mid;
+        }
+    }
+
+    for(; low < bindings->axis_event_n; low++) {
+        axis_event = &bindings->axis_events[low];
+        if(axis_event->type != type || axis_event->code != code) {
+            break;
+        }
+
+        if(type == EV_REL) {
+            /* the furthest threshold reached in the direction of motion */
+            if(axis_event->threshold < 0 && value <= axis_event->threshold) {
+                if(fired_axis_event == NULL) {
+                    fired_axis_event = axis_event;
+                }
+            } else if(
+                axis_event->threshold > 0 && value >= axis_event->threshold
+            ) {
+                fired_axis_event = axis_event;
+            }
+            continue;
+        }
+
+        hysteresis = (axis_event->exec.limit != NULL) ?
+            axis_event->exec.limit->hysteresis : 0;
+        if(axis_event->below) {
+            crossed = value <= axis_event->threshold;
+            released = value > axis_event->threshold + hysteresis;
+        } else {
+            crossed = value >= axis_event->threshold;
+            released = value < axis_event->threshold - hysteresis;
+        }
+
+        /* fires once on crossing, again only after moving back */
+        if(!test_bit(axes->latched, low) && crossed) {
+            set_bit(axes->latched, low);
+            axis_event_report(axis_event, value, src);
+        } else if(test_bit(axes->latched, low) && released) {
+            clear_bit(axes->latched, low);
+        }
+    }
+
+    if(fired_axis_event != NULL) {
+        axis_event_report(fired_axis_event, value, src);
+    }
+}
+
+static void
+axis_event_report(const axis_event_t *axis_event, int value, const char *src) {
+    conf.axis_matched++;
+
+    if(conf.verbose) {
+        fprintf(stderr, "\naxis_event:\n");
+        if(axis_event->type == EV_REL) {
+            fprintf(stderr, "  relative : %s:%+d\n",
+                axis_event_name(axis_event->type, axis_event->code),
+                axis_event->threshold);
+        } else {
+            fprintf(stderr, "  absolute : %s:%c%d\n",
+                axis_event_name(axis_event->type, axis_event->code),
+                axis_event->below ? '<' : '>', axis_event->threshold);
+        }
+        fprintf(stderr, "  value    : %d\n"
+                        "  source   : %s\n"
+                        "  exec     : \"%s\"\n\n",
+                        value,
+                        src,
+                        axis_event->exec.line
+        );
+    }
+
+    daemon_exec(&axis_event->exec);
+}
+
+void input_open_all_listener() {
+    int i, n;
+    char filename[PATH_MAX];
+    struct dirent **entries;
+
+    n = scandir("/dev/input", &entries, NULL, versionsort);
+    if(n < 0) {
+        perror(PROGRAM": scandir(/dev/input)");
+        n = 0;
+    }
+
+    for(i=0; i<n; i++) {
+        if(strncmp(entries[i]->d_name, "event", 5) != 0) {
+            free(entries[i]);
+            continue;
+        }
+
+        snprintf(filename, sizeof(filename), "/dev/input/%s",
+            entries[i]->d_name);
+        free(entries[i]);
+
+        if(access(filename, R_OK) != 0) {
+            fprintf(stderr, PROGRAM": access(%s): %s\n",
+                filename, strerror(errno));
+            continue;
+        }
+        input_add_listener(filename);
+    }
+    free(entries);
+
+    conf.listen_all = 1;
+}
+
+void input_list_devices() {
+    int fd, i, e;
+    unsigned char evmask[EV_MAX/8 + 1];
+    struct input_id id;
+
+    for(i=0; i < conf.listener_n; i++) {
+        char phys[64] = "no physical path", name[256] = "Unknown Device";
+
+        if(conf.listener[i]->path == NULL) {
+            continue;
+        }
+
+        fd = open(conf.listener[i]->path, O_RDONLY);
+        if(fd < 0) {
+            fprintf(stderr, PROGRAM": open(%s): %s\n",
+                conf.listener[i]->path, strerror(errno));
+            continue;
+        }
+
+        memset(evmask, '\0', sizeof(evmask));
+        memset(&id, '\0', sizeof(id));
+
+        ioctl(fd, EVIOCGNAME(sizeof(name)), name);
+        ioctl(fd, EVIOCGPHYS(sizeof(phys)), phys);
+        ioctl(fd, EVIOCGID, &id);
+        ioctl(fd, EVIOCGBIT(0, sizeof(evmask)), evmask);
+
+        printf("%s:\n", conf.listener[i]->path);
+        printf("  name     : %s\n", name);
+        printf("  phys     : %s\n", phys);
+        printf("  id       : %04x:%04x\n", id.vendor, id.product);
+
+        printf("  features :");
+        for(e=0; e<EV_MAX; e++) {
+            if (test_bit(evmask, e)) {
+                const char *feature = "unknown";
+                switch(e) {
+                    case EV_SYN: feature = "syn";      break;
+                    case EV_KEY: feature = "keys";     break;
+                    case EV_REL: feature = "relative"; break;
+                    case EV_ABS: feature = "absolute"; break;
+                    case EV_MSC: feature = "reserved"; break;
+                    case EV_LED: feature = "leds";     break;
+                    case EV_SND: feature = "sound";    break;
+                    case EV_REP: feature = "repeat";   break;
+                    case EV_FF:  feature = "feedback"; break;
+                    case EV_SW:  feature = "switch";   break;
+                }
+                printf(" %s", feature);
+            }
+        }
+        printf("\n\n");
+        close(fd);
+    }
+}
+
+static listener_t *input_add_listener(const char *path) {
+    listener_t *listener = NULL;
+    int i;
+
+    for(i=0; i < conf.listener_n; i++) {
+        if(conf.listener[i]->path == NULL) {
+            if(listener == NULL) {
+                listener = conf.listener[i];
+            }
+        } else if(strcmp(conf.listener[i]->path, path) == 0) {
+            return conf.listener[i];
+        }
+    }
+
+    /* listeners never move, their address is registered with epoll */
+    if(listener == NULL) {
+        conf.listener = config_grow(conf.listener, conf.listener_n,
+            &conf.listener_max, sizeof(listener_t *));
+        listener = calloc(1, sizeof(listener_t));
+        if(listener == NULL) {
+            perror(PROGRAM": calloc()");
+            exit(EXIT_FAILURE);
+        }
+        conf.listener[conf.listener_n++] = listener;
+    }
+
+    listener->path = strdup(path);
+    listener->fd = -1;
+    listener->grab = 0;
+    listener->clone_fd = -1;
+    listener->scope = 0;
+    listener->matched = 0;
+    listener->read_count = 0;
+    listener->event_count = 0;
+    listener->trace_id = 0;
+
+    return listener;
+}
+
+static unsigned int input_match_device(int fd) {
+    char name[256] = "", phys[64] = "";
+    struct input_id id;
+
+    if(bindings->device_n == 0) {
+        return 0;
+    }
+
+    memset(&id, '\0', sizeof(id));
+
+    ioctl(fd, EVIOCGNAME(sizeof(name)), name);
+    ioctl(fd, EVIOCGPHYS(sizeof(phys)), phys);
+    ioctl(fd, EVIOCGID, &id);
+
+    return input_match_rules(name, phys, &id, input_device_caps(fd));
+}
+
+static unsigned int
+input_match_rules(const char *name, const char *phys,
+    const struct input_id *id, unsigned int caps) {
+    const device_t *device;
+    int i;
+
+    /* our own clones and virtual keyboard */
+    if(strncmp(phys, UINPUT_PHYS, sizeof(UINPUT_PHYS) - 1) == 0) {
+        return 0;
+    }
+
+    /* the first rule which matches names the device */
+    for(i=0; i < bindings->device_n; i++) {
+        device = &bindings->devices[i];
+
+        if(
+            (device->name == NULL || fnmatch(device->name, name, 0) == 0) &&
+            (device->phys == NULL || fnmatch(device->phys, phys, 0) == 0) &&
+            (device->vendor < 0 || device->vendor == id->vendor) &&
+            (device->product < 0 || device->product == id->product) &&
+            (caps & device->caps) == device->caps
+        ) {
+            return i+1;
+        }
+    }
+
+    return 0;
+}
+
+static unsigned int input_device_caps(int fd) {
+    unsigned char evmask[EV_MAX/8 + 1];
+    unsigned int caps = 0;
+    int i;
+
+    memset(evmask, '\0', sizeof(evmask));
+    ioctl(fd, EVIOCGBIT(0, sizeof(evmask)), evmask);
+
+    for(i=0; i <= EV_MAX; i++) {
+        if(test_bit(evmask, i)) {
+            caps |= 1u << i;
+        }
+    }
+
+    return caps;
+}
+
+static void input_match_all() {
+    int i, n;
+    char filename[PATH_MAX];
+    struct dirent **entries;
+
+    if(bindings->device_n == 0) {
+        return;
+    }
+
+    n = scandir("/dev/input", &entries, NULL, versionsort);
+    if(n < 0) {
+        perror(PROGRAM": scandir(/dev/input)");
+        return;
+    }
+
+    for(i=0; i<n; i++) {
+        if(strncmp(entries[i]->d_name, "event", 5) == 0) {
+            snprintf(filename, sizeof(filename), "/dev/input/%s",
+                entries[i]->d_name);
+            input_match_path(filename);
+        }
+        free(entries[i]);
+    }
+    free(entries);
+}
+
+static listener_t *input_match_path(const char *path) {
+    listener_t *listener;
+    unsigned int scope;
+    int i, fd;
+
+    for(i=0; i < conf.listener_n; i++) {
+        if(
+            conf.listener[i]->path != NULL &&
+            strcmp(conf.listener[i]->path, path) == 0
+        ) {
+            return NULL;
+        }
+    }
+
+    /* only a look at the device, input_open_listener() opens it for good */
+    if((fd = open(path, O_RDONLY | O_NONBLOCK | O_CLOEXEC)) < 0) {
+        return NULL;
+    }
+    scope = input_match_device(fd);
+    close(fd);
+
+    if(scope == 0) {
+        return NULL;
+    }
+
+    listener = input_add_listener(path);
+    listener->grab = bindings->devices[scope-1].grab;
+    listener->matched = 1;
+
+    if(conf.verbose) {
+        fprintf(stderr, PROGRAM": %s matches device %s\n",
+            path, bindings->devices[scope-1].label);
+    }
+
+    return listener;
+}
+
+static void input_remove_listener(listener_t *listener) {
+    input_close_listener(listener);
+    free((void*) listener->path);
+    listener->path = NULL;
+}
+
+static int input_open_listener(listener_t *listener) {
+    int n, clock = CLOCK_MONOTONIC;
+    unsigned char sw_states[SW_MAX/8 + 1];
+    struct input_event event;
+    struct epoll_event ev = {
+        .events = EPOLLIN | EPOLLET,
+        .data.ptr = listener
+    };
+
+    /* writable, so @led can set the LEDs of the device */
+    listener->fd = open(listener->path, O_RDWR | O_NONBLOCK | O_CLOEXEC);
+    if(listener->fd < 0 && (errno == EACCES || errno == EROFS)) {
+        listener->fd = open(listener->path, O_RDONLY | O_NONBLOCK | O_CLOEXEC);
+    }
+
+    if(listener->fd < 0) {
+        return -1;
+    }
+
+    memset(&listener->keys, 0, sizeof(key_state_t));
+    memset(&listener->axes, 0, sizeof(axis_state_t));
+    memset(listener->switches, 0, sizeof(listener->switches));
+    memset(listener->consumed, 0, sizeof(listener->consumed));
+    listener->frame_n = 0;
+    listener->dropped = 0;
+
+    /* event timestamps are compared against the idle timer */
+    listener->monotonic = (ioctl(listener->fd, EVIOCSCLOCKID, &clock) == 0);
+
+    /* scoped bindings apply to listed devices as well */
+    listener->scope = input_match_device(listener->fd);
+
+    if(epoll_ctl(conf.epoll_fd, EPOLL_CTL_ADD, listener->fd, &ev) < 0) {
+        fprintf(stderr, PROGRAM": epoll_ctl(%s): %s\n",
+            listener->path, strerror(errno));
+        close(listener->fd);
+        listener->fd = -1;
+        return -1;
+    }
+
+    if(listener->grab && input_grab_listener(listener) < 0) {
+        fprintf(stderr, PROGRAM": grab(%s): %s, events are not passed on\n",
+            listener->path, strerror(errno));
+    }
+
+    if(ioctl(listener->fd, EVIOCGSW(sizeof(sw_states)), sw_states) >= 0) {
+        for (n=0; n < SW_MAX; n++) {
+            memset(&event, '\0', sizeof(event));
+            event.type = EV_SW;
+            event.code = n;
+            event.value = (sw_states[n/8] >> n%8) & 0x1;
+            input_parse_event(&event, listener);
+        }
+    }
+
+    return 0;
+}
+
+static void input_close_listener(listener_t *listener) {
+    if(listener->clone_fd >= 0) {
+        ioctl(listener->clone_fd, UI_DEV_DESTROY);
+        close(listener->clone_fd);
+        listener->clone_fd = -1;
+    }
+
+    if(listener->fd >= 0) {
+        /* closing the fd also removes it from the epoll set */
+        close(listener->fd);
+        listener->fd = -1;
+    }
+}
+
+static void input_watch_directory(const char *path) {
+    char *copy = strdup(path), *dir = dirname(copy);
+    int i, wd;
+
+    wd = inotify_add_watch(conf.inotify_fd, dir,
+        IN_CREATE | IN_ATTRIB | IN_MOVED_TO | IN_DELETE | IN_MOVED_FROM);
+
+    if(wd < 0) {
+        fprintf(stderr, PROGRAM": inotify_add_watch(%s): %s\n",
+            dir, strerror(errno));
+        free(copy);
+        return;
+    }
+
+    /* the same directory yields the same watch descriptor */
+    for(i=0; i < conf.watch_n; i++) {
+        if(conf.watch[i].wd == wd) {
+            free(copy);
+            return;
+        }
+    }
+
+    conf.watch = config_grow(conf.watch, conf.watch_n,
+        &conf.watch_max, sizeof(*conf.watch));
+    conf.watch[conf.watch_n].wd = wd;
+    conf.watch[conf.watch_n].dir = strdup(dir);
+    conf.watch_n++;
+
+    free(copy);
+}
+
+static void input_hotplug() {
+    char buffer[4096]
+        __attribute__ ((aligned(__alignof__(struct inotify_event))));
+    char path[PATH_MAX];
+    const struct inotify_event *ievent;
+    const char *dir;
+    ssize_t len;
+    char *ptr;
+    int i;
+
+    while((len = read(conf.inotify_fd, buffer, sizeof(buffer))) > 0) {
+        for(ptr = buffer; ptr < buffer + len;
+            ptr += sizeof(struct inotify_event) + ievent->len
+        ) {
+            listener_t *listener = NULL;
+
+            ievent = (const struct inotify_event *) ptr;
+            if(ievent->len == 0) {
+                continue;
+            }
+
+            for(i=0, dir=NULL; i < conf.watch_n; i++) {
+                if(conf.watch[i].wd == ievent->wd) {
+                    dir = conf.watch[i].dir;
+                    break;
+                }
+            }
+            if(dir == NULL) {
+                continue;
+            }
+
+            snprintf(path, sizeof(path), "%s/%s", dir, ievent->name);
+
+            for(i=0; i < conf.listener_n; i++) {
+                if(
+                    conf.listener[i]->path != NULL &&
+                    strcmp(conf.listener[i]->path, path) == 0
+                ) {
+                    listener = conf.listener[i];
+                    break;
+                }
+            }
+
+            /* when listening to everything, pick up new event devices */
+            if(
+                listener == NULL && conf.listen_all &&
+                strcmp(dir, "/dev/input") == 0 &&
+                strncmp(ievent->name, "event", 5) == 0 &&
+                (ievent->mask & (IN_CREATE | IN_ATTRIB | IN_MOVED_TO))
+            ) {
+                listener = input_add_listener(path);
+            }
+
+            /* device rules look at every new event device once */
+            if(
+                listener == NULL && bindings->device_n > 0 &&
+                strcmp(dir, "/dev/input") == 0 &&
+                strncmp(ievent->name, "event", 5) == 0 &&
+                (ievent->mask & (IN_CREATE | IN_ATTRIB | IN_MOVED_TO))
+            ) {
+                listener = input_match_path(path);
+            }
+
+            if(listener == NULL) {
+                continue;
+            }
+
+            if(ievent->mask & (IN_DELETE | IN_MOVED_FROM)) {
+                if(listener->fd >= 0) {
+                    input_close_listener(listener);
+                    if(conf.verbose || conf.monitor) {
+                        fprintf(stderr, PROGRAM": %s removed\n", path);
+                    }
+                }
+
+                /* the next device at this path is matched anew */
+                if(listener->matched) {
+                    input_remove_listener(listener);
+                }
+            } else if(listener->fd < 0) {
+                /* permissions may only be set with a later IN_ATTRIB */
+                if(input_open_listener(listener) == 0) {
+                    if(conf.verbose || conf.monitor) {
+                        fprintf(stderr, PROGRAM": %s added\n", path);
+                    }
+                } else if(errno != EACCES && errno != ENOENT) {
+                    fprintf(stderr, PROGRAM": open(%s): %s\n",
+                        path, strerror(errno));
+                }
+            }
+        }
+    }
+}
+
+static int input_read_events(listener_t *listener) {
+    struct input_event events[READ_BATCH];
+    ssize_t len;
+    size_t i, n, count = 0;
+
+    /* drain the kernel buffer, a short read means it is empty */
+    do {
+        len = read(listener->fd, events, sizeof(events));
+
+        if(len < 0) {
+            if(errno == EINTR) {
+                continue;
+            } else if(errno == EAGAIN || errno == EWOULDBLOCK) {
+                break;
+            }
+            fprintf(stderr, PROGRAM": read(%s): %s\n",
+                listener->path, strerror(errno));
+            return -1;
+        } else if(len == 0) {
+            break;
+        }
+
+        n = len / sizeof(struct input_event);
+
+        conf.read_count++;
+        conf.event_count += n;
+        listener->read_count++;
+        listener->event_count += n;
+
+        if(conf.capture != NULL) {
+            input_capture_events(listener, events, n);
+        }
+
+        if(conf.idle && n > 0) {
+            idle_event_reset();
+        }
+
+        conf.source = listener;
+        for(i=0; i < n; i++) {
+            /* start of the dispatch latency, see daemon_exec() */
+            if(listener->monotonic) {
+                conf.event_us =
+                    (unsigned long long) events[i].input_event_sec * 1000000 +
+                    events[i].input_event_usec;
+            }
+            if(conf.monitor == MONITOR_EVENTS) {
+                monitor_event(&events[i], listener);
+            }
+            input_frame_event(&events[i], listener);
+        }
+        conf.event_us = 0;
+        conf.source = NULL;
+
+        if(n > 0 && listener->monotonic) {
+            conf.input_last =
+                (unsigned long long) events[n-1].input_event_sec * 1000000 +
+                events[n-1].input_event_usec;
+        }
+        count += n;
+    } while(len == sizeof(events));
+
+    /* devices without EVIOCSCLOCKID report wall-clock timestamps */
+    if(count > 0 && !listener->monotonic) {
+        conf.input_last = daemon_monotonic_us();
+    }
+
+    return count;
+}
+
+static void input_parse_event(struct input_event *event, listener_t *listener) {
+    key_event_t *fired_key_event;
+    switch_event_t *fired_switch_event;
+    key_state_t *state = conf.global_key_state ?
+        &conf.key_state : &listener->keys;
+    const char *src = listener->path;
+
+    switch(event->type) {
+        case EV_KEY:
+            /* with a global key state, the device of the last key decides */
+            state->current.scope = listener->scope;
+
+            if(event->value == 2) {
+                /* autorepeat, only looked at if a binding asks for it */
+                fired_key_event = (bindings->repeat_n > 0) ?
+                    key_event_repeat(event->code, state, src) : NULL;
+            } else {
+                fired_key_event = key_event_parse(event->code, event->value,
+                    state, src);
+
+                if(bindings->gesture_n > 0) {
+                    gesture_event_key(event->code, event->value, state, src);
+                }
+            }
+
+            if(fired_key_event != NULL) {
+                conf.key_matched++;
+                daemon_exec(&fired_key_event->exec);
+            }
+            break;
+        case EV_SW:
+            if(event->code < SW_CNT) {
+                if(event->value) {
+                    set_bit(listener->switches, event->code);
+                } else {
+                    clear_bit(listener->switches, event->code);
+                }
+            }
+
+            fired_switch_event = switch_event_parse(event->code, event->value,
+                listener->scope, src);
+
+            if(fired_switch_event != NULL) {
+                conf.switch_matched++;
+                daemon_exec(&fired_switch_event->exec);
+            }
+
+            break;
+        case EV_REL:
+        case EV_ABS:
+            axis_event_update(event, &listener->axes);
+            break;
+    }
+}
+
+static void input_frame_event(struct input_event *event, listener_t *listener) {
+    /* after SYN_DROPPED everything up to the next report is incomplete */
+    if(listener->dropped) {
+        if(event->type == EV_SYN && event->code == SYN_REPORT) {
+            listener->dropped = 0;
+            input_resync(listener);
+        }
+        return;
+    }
+
+    if(event->type == EV_SYN && event->code == SYN_REPORT) {
+        input_frame_flush(listener);
+    } else if(event->type == EV_SYN && event->code == SYN_DROPPED) {
+        listener->frame_n = 0;
+        listener->axes.rel_changed = 0;
+        listener->axes.abs_changed = 0;
+        memset(listener->axes.rel, 0, sizeof(listener->axes.rel));
+        listener->dropped = 1;
+    } else if(
+        event->type == EV_KEY || event->type == EV_SW ||
+        listener->clone_fd >= 0
+    ) {
+        /* grabbed devices keep the order of everything they pass on */
+        input_frame_add(listener, event);
+    } else if(event->type == EV_REL || event->type == EV_ABS) {
+        /* summed up per frame already */
+        input_parse_event(event, listener);
+    }
+}
+
+static void
+input_frame_add(listener_t *listener, const struct input_event *event) {
+    if(listener->frame_n == FRAME_EVENTS) {
+        input_frame_flush(listener);
+    }
+    listener->frame[listener->frame_n++] = *event;
+}
+
+static void input_frame_flush(listener_t *listener) {
+    struct input_event *event;
+    size_t i, n = 0;
+
+    for(i=0; i < listener->frame_n; i++) {
+        event = &listener->frame[i];
+        input_parse_event(event, listener);
+
+        /* compacted in place, what is left is passed on */
+        if(listener->clone_fd >= 0 && !input_frame_consumed(listener, event)) {
+            listener->frame[n++] = *event;
+        }
+    }
+    listener->frame_n = 0;
+
+    if(listener->axes.rel_changed || listener->axes.abs_changed) {
+        axis_event_frame(&listener->axes, listener->path);
+    }
+
+    if(listener->clone_fd < 0 || n == 0) {
+        return;
+    }
+
+    /* one write per frame, the kernel timestamps them anew */
+    memset(&listener->frame[n], 0, sizeof(struct input_event));
+    listener->frame[n].type = EV_SYN;
+    listener->frame[n++].code = SYN_REPORT;
+
+    if(write(listener->clone_fd, listener->frame,
+        n * sizeof(struct input_event)) < 0
+    ) {
+        fprintf(stderr, PROGRAM": write(%s clone): %s\n",
+            listener->path, strerror(errno));
+    } else if(conf.event_us > 0) {
+        daemon_stats_add(&conf.passthrough,
+            daemon_monotonic_us() - conf.event_us);
+    }
+}
+
+static int
+input_frame_consumed(listener_t *listener, const struct input_event *event) {
+    const key_state_t *state = conf.global_key_state ?
+        &conf.key_state : &listener->keys;
+
+    if(event->type != EV_KEY || event->code >= KEY_CNT) {
+        return 0;
+    }
+
+    /* a bound shortcut or sequence step, its key is hidden up to and
+     * including the release */
+    if(event->value == 1) {
+        if(state->current.code == event->code && (
+            key_event_lookup(&state->current) != NULL || (
+                state->gesture_code == event->code &&
+                state->gesture_phase != GESTURE_IDLE
+            ) || (
+                bindings->sequence_event_n > 0 && sequence_event_step(state)
+            )
+        )) {
+            set_bit(listener->consumed, event->code);
+            return 1;
+        }
+        return 0;
+    }
+
+    if(!test_bit(listener->consumed, event->code)) {
+        return 0;
+    }
+    if(event->value == 0) {
+        clear_bit(listener->consumed, event->code);
+    }
+    return 1;
+}
+
+static void input_resync(listener_t *listener) {
+    unsigned char caps[KEY_CNT/8 + 1], keys[KEY_CNT/8 + 1];
+    unsigned char switches[SW_CNT/8 + 1], diff;
+    key_state_t *state = conf.global_key_state ?
+        &conf.key_state : &listener->keys;
+    struct input_absinfo absinfo;
+    struct input_event event;
+    unsigned long long mask;
+    unsigned int code;
+    int pressed, i;
+
+    conf.resync_count++;
+    if(conf.verbose) {
+        fprintf(stderr, PROGRAM": %s: events dropped, resynchronizing\n",
+            listener->path);
+    }
+
+    memset(&event, 0, sizeof(event));
+    memset(caps, 0, sizeof(caps));
+    memset(keys, 0, sizeof(keys));
+
+    /* only keys of this device, others may share a global key state */
+    if(
+        ioctl(listener->fd, EVIOCGBIT(EV_KEY, sizeof(caps)), caps) >= 0 &&
+        ioctl(listener->fd, EVIOCGKEY(sizeof(keys)), keys) >= 0
+    ) {
+        event.type = EV_KEY;
+
+        /* releases first, so stale modifiers are gone before any press */
+        for(pressed=0; pressed <= 1; pressed++) {
+            for(i=0; i < sizeof(keys); i++) {
+                diff = (keys[i] ^ state->down[i]) & caps[i] &
+                    (pressed ? keys[i] : ~keys[i]);
+
+                while(diff) {
+                    code = i*8 + __builtin_ctz(diff);
+                    diff &= diff - 1;
+
+                    event.code = code;
+                    event.value = pressed;
+                    input_frame_add(listener, &event);
+                }
+            }
+        }
+    }
+
+    if(ioctl(listener->fd, EVIOCGSW(sizeof(switches)), switches) >= 0) {
+        event.type = EV_SW;
+
+        for(i=0; i < sizeof(switches); i++) {
+            diff = switches[i] ^ listener->switches[i];
+
+            while(diff) {
+                code = i*8 + __builtin_ctz(diff);
+                diff &= diff - 1;
+
+                event.code = code;
+                event.value = test_bit(switches, code) ? 1 : 0;
+                input_frame_add(listener, &event);
+            }
+        }
+    }
+
+    /* absolute bindings compare against the value they missed */
+    mask = bindings->abs_mask;
+    if(listener->clone_fd >= 0) {
+        /* the clone needs all of them */
+        ioctl(listener->fd, EVIOCGBIT(EV_ABS, sizeof(mask)), &mask);
+    }
+
+    event.type = EV_ABS;
+    for(; mask; mask &= mask - 1) {
+        code = __builtin_ctzll(mask);
+
+        if(ioctl(listener->fd, EVIOCGABS(code), &absinfo) >= 0) {
+            event.code = code;
+            event.value = absinfo.value;
+            input_frame_add(listener, &event);
+        }
+    }
+
+    /* the differences form one report */
+    input_frame_flush(listener);
+}
+
+static int input_grab_listener(listener_t *listener) {
+    static const struct {
+        unsigned short  type;
+        unsigned short  count;
+        unsigned long   request;
+    } EVENT_BITS[] = {
+        { EV_KEY, KEY_CNT, UI_SET_KEYBIT },
+        { EV_REL, REL_CNT, UI_SET_RELBIT },
+        { EV_ABS, ABS_CNT, UI_SET_ABSBIT },
+        { EV_MSC, MSC_CNT, UI_SET_MSCBIT },
+        { EV_SW,  SW_CNT,  UI_SET_SWBIT  },
+        { EV_LED, LED_CNT, UI_SET_LEDBIT },
+        { EV_SND, SND_CNT, UI_SET_SNDBIT },
+    };
+    unsigned char types[EV_CNT/8 + 1], bits[KEY_CNT/8 + 1];
+    unsigned char props[INPUT_PROP_CNT/8 + 1];
+    struct uinput_user_dev dev;
+    struct input_absinfo absinfo;
+    int fd, i, code, error;
+
+    /* the clone exists before the grab, so no event gets lost */
+    if((fd = open("/dev/uinput", O_WRONLY | O_NONBLOCK | O_CLOEXEC)) < 0) {
+        return -1;
+    }
+
+    memset(&dev, 0, sizeof(dev));
+    ioctl(listener->fd, EVIOCGNAME(sizeof(dev.name)), dev.name);
+    ioctl(listener->fd, EVIOCGID, &dev.id);
+
+    memset(types, 0, sizeof(types));
+    ioctl(listener->fd, EVIOCGBIT(0, sizeof(types)), types);
+    ioctl(fd, UI_SET_EVBIT, EV_SYN);
+
+    /* autorepeat is passed on from the device, not generated twice */
+    for(i=0; i < sizeof(EVENT_BITS) / sizeof(EVENT_BITS[0]); i++) {
+        if(!test_bit(types, EVENT_BITS[i].type)) {
+            continue;
+        }
+        ioctl(fd, UI_SET_EVBIT, EVENT_BITS[i].type);
+
+        memset(bits, 0, sizeof(bits));
+        ioctl(listener->fd, EVIOCGBIT(EVENT_BITS[i].type, sizeof(bits)), bits);
+        for(code=0; code < EVENT_BITS[i].count; code++) {
+            if(!test_bit(bits, code)) {
+                continue;
+            }
+            ioctl(fd, EVENT_BITS[i].request, code);
+
+            if(
+                EVENT_BITS[i].type == EV_ABS &&
+                ioctl(listener->fd, EVIOCGABS(code), &absinfo) >= 0
+            ) {
+                dev.absmin[code] = absinfo.minimum;
+                dev.absmax[code] = absinfo.maximum;
+                dev.absfuzz[code] = absinfo.fuzz;
+                dev.absflat[code] = absinfo.flat;
+            }
+        }
+    }
+
+    memset(props, 0, sizeof(props));
+    ioctl(listener->fd, EVIOCGPROP(sizeof(props)), props);
+    for(code=0; code < INPUT_PROP_CNT; code++) {
+        if(test_bit(props, code)) {
+            ioctl(fd, UI_SET_PROPBIT, code);
+        }
+    }
+
+    /* same name and id, a rule would match and grab the clone again */
+    ioctl(fd, UI_SET_PHYS, UINPUT_PHYS);
+
+    if(
+        write(fd, &dev, sizeof(dev)) != sizeof(dev) ||
+        ioctl(fd, UI_DEV_CREATE) < 0
+    ) {
+        error = errno;
+        close(fd);
+        errno = error;
+        return -1;
+    }
+
+    if(ioctl(listener->fd, EVIOCGRAB, 1) < 0) {
+        error = errno;
+        ioctl(fd, UI_DEV_DESTROY);
+        close(fd);
+        errno = error;
+        return -1;
+    }
+
+    listener->clone_fd = fd;
+
+    if(conf.verbose) {
+        fprintf(stderr, PROGRAM": grabbed %s, passing events on to \"%s\"\n",
+            listener->path, dev.name);
+    }
+
+    return 0;
+}
+
+static void input_capture_device(listener_t *listener) {
+    char name[256] = "Unknown Device", phys[64] = "", caps[9];
+    struct input_id id;
+    trace_record_t record;
+
+    memset(&id, 0, sizeof(id));
+    ioctl(listener->fd, EVIOCGNAME(sizeof(name)), name);
+    ioctl(listener->fd, EVIOCGPHYS(sizeof(phys)), phys);
+    ioctl(listener->fd, EVIOCGID, &id);
+
+    /* what device rules look at, so a replay scopes bindings alike */
+    snprintf(caps, sizeof(caps), "%08x", input_device_caps(listener->fd));
+
+    memset(&record, 0, sizeof(record));
+    listener->trace_id = ++conf.trace_devices;
+    record.device = listener->trace_id;
+    record.type   = TRACE_DEVICE;
+    record.length = sizeof(id) + strlen(listener->path) + 1 + strlen(name) + 1 +
+        strlen(phys) + 1 + strlen(caps) + 1;
+
+    fwrite(&record, sizeof(record), 1, conf.capture);
+    fwrite(&id, sizeof(id), 1, conf.capture);
+    fwrite(listener->path, strlen(listener->path) + 1, 1, conf.capture);
+    fwrite(name, strlen(name) + 1, 1, conf.capture);
+    fwrite(phys, strlen(phys) + 1, 1, conf.capture);
+    fwrite(caps, strlen(caps) + 1, 1, conf.capture);
+}
+
+static void
+input_capture_events(listener_t *listener, const struct input_event *events,
+    size_t n) {
+    trace_record_t record;
+    size_t i;
+
+    /* a device is described once, before its first event */
+    if(listener->trace_id == 0) {
+        input_capture_device(listener);
+    }
+
+    memset(&record, 0, sizeof(record));
+    record.device = listener->trace_id;
+
+    for(i=0; i < n; i++) {
+        record.sec   = events[i].input_event_sec;
+        record.usec  = events[i].input_event_usec;
+        record.type  = events[i].type;
+        record.code  = events[i].code;
+        record.value = events[i].value;
+
+        fwrite(&record, sizeof(record), 1, conf.capture);
+    }
+}
+
+static int input_replay_compare(const void *a, const void *b) {
+    unsigned long x = *(const unsigned long *) a;
+    unsigned long y = *(const unsigned long *) b;
+
+    return (x > y) - (x < y);
+}
+
+static int
+input_replay_scope(listener_t *listener, const char *info, size_t length) {
+    const char *name, *phys, *caps, *end = info + length;
+
+    if(bindings->device_n == 0) {
+        return 0;
+    }
+
+    /* id, path, name, then phys and types, see input_capture_device() */
+    name = info + sizeof(struct input_id);
+    name += strlen(name) + 1;
+    phys = (name < end) ? name + strlen(name) + 1 : end;
+    caps = (phys < end) ? phys + strlen(phys) + 1 : end;
+
+    if(caps >= end) {
+        return -1;
+    }
+
+    listener->scope = input_match_rules(name, phys,
+        (const struct input_id *) info, strtoul(caps, NULL, 16));
+
+    return 0;
+}
+
+static int input_replay(const char *path) {
+    FILE *trace;
+    trace_record_t record;
+    struct input_event *events = NULL, *event;
+    unsigned short *devices = NULL;
+    listener_t *listener = NULL;
+    unsigned long *latency;
+    size_t event_n = 0, event_max = 0, listener_n = 0, total, i, j, k;
+    unsigned long long start, elapsed;
+    struct timespec before, after;
+    char magic[sizeof(TRACE_MAGIC) - 1];
+
+    if((trace = fopen(path, "r")) == NULL) {
+        fprintf(stderr, PROGRAM": fopen(%s): %s\n", path, strerror(errno));
+        return -1;
+    }
+
+    if(
+        fread(magic, sizeof(magic), 1, trace) != 1 ||
+        memcmp(magic, TRACE_MAGIC, sizeof(magic)) != 0
+    ) {
+        fprintf(stderr, PROGRAM": %s: not a trace file\n", path);
+        fclose(trace);
+        return -1;
+    }
+
+    /* load the whole trace, replaying must not touch the disk */
+    while(fread(&record, sizeof(record), 1, trace) == 1) {
+        /* devices are numbered in the order they are announced, and
+         * announced before their first event */
+        if(
+            record.device == 0 || record.device > listener_n + 1 ||
+            (record.device > listener_n && record.type != TRACE_DEVICE) ||
+            (record.device <= listener_n && record.type == TRACE_DEVICE)
+        ) {
+            fprintf(stderr, PROGRAM": %s: invalid record\n", path);
+            break;
+        }
+
+        if(record.device > listener_n) {
+            listener = realloc(listener, record.device * sizeof(listener_t));
+            if(listener == NULL) {
+                perror(PROGRAM": realloc()");
+                exit(EXIT_FAILURE);
+            }
+            memset(&listener[listener_n], 0, sizeof(listener_t));
+            listener[listener_n].path = "unknown";
+            listener[listener_n].fd = -1;
+            listener[listener_n].clone_fd = -1;
+            listener_n = record.device;
+        }
+
+        if(record.type == TRACE_DEVICE) {
+            char *info = malloc(record.length);
+
+            if(
+                info == NULL || record.length <= sizeof(struct input_id) ||
+                fread(info, record.length, 1, trace) != 1
+            ) {
+                fprintf(stderr, PROGRAM": %s: truncated device record\n",
+                    path);
+                free(info);
+                break;
+            }
+            info[record.length - 1] = '\0';
+            listener[record.device-1].path =
+                strdup(info + sizeof(struct input_id));
+
+            if(input_replay_scope(&listener[record.device-1], info,
+                record.length) < 0
+            ) {
+                fprintf(stderr, PROGRAM": %s: device %s has no physical "
+                    "path and types recorded, device rules can not be "
+                    "matched\n", path, listener[record.device-1].path);
+                free(info);
+                fclose(trace);
+                return -1;
+            }
+            free(info);
+            continue;
+        }
+
+        events = config_grow(events, event_n, &event_max,
+            sizeof(struct input_event));
+        devices = realloc(devices, event_max * sizeof(unsigned short));
+        if(devices == NULL) {
+            perror(PROGRAM": realloc()");
+            exit(EXIT_FAILURE);
+        }
+
+        memset(&events[event_n], 0, sizeof(struct input_event));
+        events[event_n].type  = record.type;
+        events[event_n].code  = record.code;
+        events[event_n].value = record.value;
+        devices[event_n++] = record.device;
+    }
+    fclose(trace);
+
+    if(event_n == 0) {
+        fprintf(stderr, PROGRAM": %s: no events\n", path);
+        return -1;
+    }
+
+    /* repeat short traces for a stable measurement */
+    total = (event_n < REPLAY_EVENTS) ?
+        (REPLAY_EVENTS / event_n + 1) * event_n : event_n;
+
+    if((latency = malloc(total * sizeof(unsigned long))) == NULL) {
+        perror(PROGRAM": malloc()");
+        exit(EXIT_FAILURE);
+    }
+
+    conf.replay = 1;
+    start = daemon_monotonic_us();
+
+    for(i=0; i < total; i++) {
+        j = i % event_n;
+        event = &events[j];
+
+        /* every pass starts with all keys released */
+        if(j == 0) {
+            for(k=0; k < listener_n; k++) {
+                memset(&listener[k].keys, 0, sizeof(key_state_t));
+                listener[k].frame_n = 0;
+                listener[k].dropped = 0;
+            }
+            memset(&conf.key_state, 0, sizeof(key_state_t));
+        }
+
+        clock_gettime(CLOCK_MONOTONIC, &before);
+        input_frame_event(event, &listener[devices[j]-1]);
+        clock_gettime(CLOCK_MONOTONIC, &after);
+
+        latency[i] = (after.tv_sec - before.tv_sec) * 1000000000UL +
+            after.tv_nsec - before.tv_nsec;
+    }
+
+    elapsed = daemon_monotonic_us() - start;
+
+    qsort(latency, total, sizeof(unsigned long), input_replay_compare);
+
+    printf("%s: %zu events from %zu devices, replayed %zu times\n",
+        path, event_n, listener_n, total / event_n);
+    printf("  bindings : %zu keys, %zu switches, %zu axes\n",
+        bindings->key_event_n, bindings->switch_event_n,
+        bindings->axis_event_n);
+    printf("  matched  : %lu keys, %lu sequences, %lu switches, %lu axes "
+        "(not executed)\n", conf.key_matched, conf.sequence_matched,
+        conf.switch_matched, conf.axis_matched);
+    printf("  rate     : %.0f events/s (%llu us total)\n",
+        elapsed ? total * 1000000.0 / elapsed : 0.0, elapsed);
+    printf("  latency  : p50 %lu ns, p90 %lu ns, p99 %lu ns, "
+        "p99.9 %lu ns, max %lu ns\n",
+        latency[total / 2], latency[total * 9 / 10],
+        latency[total * 99 / 100], latency[total * 999 / 1000],
+        latency[total - 1]);
+
+    /* daemon_clean() leaves with _exit() */
+    fflush(stdout);
+
+    free(latency);
+    free(events);
+    free(devices);
+    for(i=0; i < listener_n; i++) {
+        if(strcmp(listener[i].path, "unknown") != 0) {
+            free((void*) listener[i].path);
+        }
+    }
+    free(listener);
+
+    return 0;
+}
+
+
+static void monitor_init() {
+    struct epoll_event ev = {
+        .events = 0,
+        .data.ptr = &conf.monitor_fd
+    };
+
+    /* a slow reader must not stall reading the devices; the flag belongs
+     * to the open file, so a terminal shared with the shell is opened anew */
+    conf.monitor_fd = STDOUT_FILENO;
+    if(isatty(STDOUT_FILENO) && ttyname(STDOUT_FILENO) != NULL) {
+        conf.monitor_fd = open(ttyname(STDOUT_FILENO),
+            O_WRONLY | O_NOCTTY | O_NONBLOCK | O_CLOEXEC);
+        if(conf.monitor_fd < 0) {
+            conf.monitor_fd = STDOUT_FILENO;
+        }
+    }
+    if((conf.monitor_flags = fcntl(conf.monitor_fd, F_GETFL)) >= 0) {
+        conf.monitor_flags &= ~O_NONBLOCK;
+        fcntl(conf.monitor_fd, F_SETFL, conf.monitor_flags | O_NONBLOCK);
+    }
+
+    /* regular files never block and can't be polled, they are just written */
+    conf.monitor_polled =
+        (epoll_ctl(conf.epoll_fd, EPOLL_CTL_ADD, conf.monitor_fd, &ev) == 0);
+}
+
+static void monitor_printf(const char *format, ...) {
+    char line[MONITOR_LINE];
+    size_t len, tail, n;
+    va_list args;
+    int r;
+
+    if(conf.monitor_dropped > conf.monitor_reported &&
+        conf.monitor_len + 64 + MONITOR_LINE <= MONITOR_RING
+    ) {
+        conf.monitor_reported = conf.monitor_dropped;
+        monitor_printf(conf.monitor == MONITOR_EVENTS ? "# dropped %lu\n" :
+            PROGRAM": %lu lines dropped\n\n", conf.monitor_dropped);
+    }
+
+    va_start(args, format);
+    r = vsnprintf(line, sizeof(line), format, args);
+    va_end(args);
+
+    if(r < 0) {
+        return;
+    }
+    len = ((size_t) r < sizeof(line)) ? (size_t) r : sizeof(line) - 1;
+
+    /* whole lines only, a consumer which can't keep up loses the newest */
+    if(conf.monitor_len + len > MONITOR_RING) {
+        monitor_flush();
+    }
+    if(conf.monitor_len + len > MONITOR_RING) {
+        conf.monitor_dropped++;
+        return;
+    }
+
+    tail = (conf.monitor_head + conf.monitor_len) % MONITOR_RING;
+    n = (len < MONITOR_RING - tail) ? len : MONITOR_RING - tail;
+    memcpy(conf.monitor_ring + tail, line, n);
+    memcpy(conf.monitor_ring, line + n, len - n);
+    conf.monitor_len += len;
+}
+
+static void
+monitor_event(const struct input_event *event, listener_t *listener) {
+    monitor_printf("%ld.%06ld %s %u %u %d\n",
+        (long) event->input_event_sec, (long) event->input_event_usec,
+        listener->path, event->type, event->code, event->value);
+}
+
+static int monitor_flush() {
+    struct epoll_event ev = {
+        .events = 0,
+        .data.ptr = &conf.monitor_fd
+    };
+    ssize_t written;
+    size_t n;
+
+    while(conf.monitor_len > 0) {
+        n = MONITOR_RING - conf.monitor_head;
+        if(n > conf.monitor_len) {
+            n = conf.monitor_len;
+        }
+
+        if((written = write(conf.monitor_fd,
+            conf.monitor_ring + conf.monitor_head, n)) < 0
+        ) {
+            if(errno == EINTR) {
+                continue;
+            } else if(errno != EAGAIN && errno != EWOULDBLOCK) {
+                /* nobody is reading any more */
+                conf.monitor_dropped += conf.monitor_len > 0;
+                conf.monitor_len = 0;
+            }
+            break;
+        }
+
+        conf.monitor_head = (conf.monitor_head + written) % MONITOR_RING;
+        conf.monitor_len -= written;
+    }
+
+    if(conf.monitor_len == 0) {
+        conf.monitor_head = 0;
+    }
+
+    /* only wait for the terminal while there is something left */
+    if(conf.monitor_polled) {
+        ev.events = (conf.monitor_len > 0) ? EPOLLOUT : 0;
+        epoll_ctl(conf.epoll_fd, EPOLL_CTL_MOD, conf.monitor_fd, &ev);
+    }
+
+    return conf.monitor_len;
+}
+
+static void monitor_clean() {
+    /* the rest is written blocking, nothing is read any more */
+    if(conf.monitor_flags >= 0) {
+        fcntl(conf.monitor_fd, F_SETFL, conf.monitor_flags);
+    }
+    conf.monitor_polled = 0;
+    monitor_flush();
+
+    if(conf.monitor_fd != STDOUT_FILENO) {
+        close(conf.monitor_fd);
+    }
+
+    if(conf.monitor_dropped > 0) {
+        fprintf(stderr, PROGRAM": %lu monitor lines dropped\n",
+            conf.monitor_dropped);
+    }
+}
+
+static void *arena_alloc(arena_t *arena, size_t size) {
+    arena_block_t *block = arena->head;
+    void *ptr;
+
+    size = (size + ARENA_ALIGN - 1) & ~(size_t) (ARENA_ALIGN - 1);
+
+    if(block == NULL || block->used + size > block->size) {
+        size_t block_size = (size > ARENA_BLOCK) ? size : ARENA_BLOCK;
+
+        if((block = malloc(sizeof(arena_block_t) + block_size)) == NULL) {
+            perror(PROGRAM": malloc()");
+            exit(EXIT_FAILURE);
+        }
+        block->size = block_size;
+        block->used = 0;
+
+        /* keep filling the current block after an oversized one */
+        if(arena->head != NULL && size > ARENA_BLOCK) {
+            block->next = arena->head->next;
+            arena->head->next = block;
+        } else {
+            block->next = arena->head;
+            arena->head = block;
+        }
+    }
+
+    ptr = block->data + block->used;
+    block->used += size;
+
+    return ptr;
+}
+
+static void *arena_memdup(arena_t *arena, const void *ptr, size_t size) {
+    return memcpy(arena_alloc(arena, size), ptr, size);
+}
+
+static char *arena_strdup(arena_t *arena, const char *str) {
+    size_t len = strlen(str) + 1;
+
+    return memcpy(arena_alloc(arena, len), str, len);
+}
+
+static void *arena_move(arena_t *arena, void *ptr, size_t size) {
+    void *new = NULL;
+
+    if(size > 0) {
+        new = memcpy(arena_alloc(arena, size), ptr, size);
+    }
+    free(ptr);
+
+    return new;
+}
+
+static void arena_free(arena_t *arena) {
+    arena_block_t *block, *next;
+
+    for(block = arena->head; block != NULL; block = next) {
+        next = block->next;
+        free(block);
+    }
+    arena->head = NULL;
+}
+
+static bindings_t *config_new_bindings() {
+    arena_t arena = { NULL };
+    bindings_t *new = arena_alloc(&arena, sizeof(bindings_t));
+
+    memset(new, 0, sizeof(bindings_t));
+    new->arena = arena;
+    new->exec_mode = EXEC_DIRECT;
+
+    new->key_event_table_size = 16;
+    new->key_event_table = calloc(new->key_event_table_size,
+        sizeof(unsigned int));
+    new->sequence_event_table_size = 16;
+    new->sequence_event_table = calloc(new->sequence_event_table_size,
+        sizeof(unsigned int));
+    if(new->key_event_table == NULL || new->sequence_event_table == NULL) {
+        perror(PROGRAM": calloc()");
+        exit(EXIT_FAILURE);
+    }
+
+    return new;
+}
+
+bindings_t *config_parse_file() {
+    bindings_t *new;
+    FILE *config_fd;
+    char buffer[512], *line;
+    char *section = NULL;
+    char *key, *value, *ptr;
     const char *error = NULL;
+    limit_t *limit;
+    unsigned int scope = 0;
     int line_num = 0;
-    int listen_len = 0;
 
-    if((config_fd = fopen(conf.configfile, "r")) == NULL) {
-        fprintf(stderr, PROGRAM": fopen(%s): %s\n",
-            conf.configfile, strerror(errno));
+    if((config_fd = fopen(conf.configfile, "r")) == NULL) {
+        fprintf(stderr, PROGRAM": fopen(%s): %s\n",
+            conf.configfile, strerror(errno));
+        return NULL;
+    }
+
+    new = config_new_bindings();
+
+    memset(buffer, 0, sizeof(buffer));
+
+    while(fgets(buffer, sizeof(buffer), config_fd) != NULL) {
+        line = config_trim_string(buffer);
+        line_num++;
+        error = NULL;
+
+        if(line[0] == '\0' || line[0] == '#') {
+            continue;
+        }
+
+        if((ptr = strchr(line, '#'))) {
+            *ptr = '\0';
+        }
+
+        if(line[0] == '[' && line[strlen(line)-1] == ']') {
+            if(section != NULL) {
+                free(section);
+            }
+            line[strlen(line)-1] = '\0';
+            section = strdup(config_trim_string(line+1));
+
+            /* '[Keys:LABEL]' only applies to the devices of a rule */
+            scope = 0;
+            if((ptr = strchr(section, ':')) != NULL) {
+                *ptr++ = '\0';
+                ptr = config_trim_string(ptr);
+                config_trim_string(section);
+
+                while(
+                    scope < new->device_n &&
+                    strcmp(new->devices[scope].label, ptr) != 0
+                ) {
+                    scope++;
+                }
+                if(scope == new->device_n) {
+                    error = "Unknown device!";
+                    free(section);
+                    section = NULL;
+                    goto print_error;
+                }
+                scope++;
+            }
+            continue;
+        }
+
+        key = value = line;
+        strsep(&value, "=");
+        if(value == NULL) {
+            error = "Invalid syntax!";
+            goto print_error;
+        }
+
+        key = config_trim_string(key);
+        value = config_trim_string(value);
+
+        if(section == NULL) {
+            error = "Missing section!";
+        } else if(strlen(key) == 0 || strlen(value) == 0) {
+            error = "Invlaid syntax!";
+        } else if(strcasecmp(section, "Global") == 0) {
+            if(strcmp(key, "listen") == 0) {
+                new->listen = config_grow(new->listen, new->listen_n,
+                    &new->listen_max, sizeof(listen_t));
+                new->listen[new->listen_n].grab = 0;
+
+                /* 'PATH (grab)' takes the device away from everyone else */
+                if((ptr = strchr(value, '(')) != NULL &&
+                    value[strlen(value)-1] == ')'
+                ) {
+                    *ptr++ = '\0';
+                    ptr[strlen(ptr)-1] = '\0';
+                    if(strcasecmp(config_trim_string(ptr), "grab") != 0) {
+                        error = "Unknown option!";
+                        goto print_error;
+                    }
+                    new->listen[new->listen_n].grab = 1;
+                    value = config_trim_string(value);
+                }
+                new->listen[new->listen_n++].path =
+                    arena_strdup(&new->arena, value);
+            } else if(strncmp(key, "device", 6) == 0 && isspace(key[6])) {
+                error = config_device(new, config_trim_string(key+6), value);
+            } else if(strcmp(key, "key_state") == 0) {
+                if(strcasecmp(value, "device") == 0) {
+                    new->global_key_state = 0;
+                } else if(strcasecmp(value, "global") == 0) {
+                    new->global_key_state = 1;
+                } else {
+                    error = "Invalid key state!";
+                }
+            } else if(strcmp(key, "stats") == 0) {
+                new->stats_file = arena_strdup(&new->arena, value);
+            } else if(strcmp(key, "exec_mode") == 0) {
+                if(strcasecmp(value, "shell") == 0) {
+                    new->exec_mode = EXEC_SHELL;
+                } else if(strcasecmp(value, "direct") == 0) {
+                    new->exec_mode = EXEC_DIRECT;
+                } else if(strcasecmp(value, "helper") == 0) {
+                    new->exec_mode = EXEC_HELPER;
+                } else {
+                    error = "Invalid exec mode!";
+                }
+            } else {
+                error = "Unkown option!";
+            }
+        } else if(
+            scope != 0 && strcasecmp(section, "Keys") != 0 &&
+            strcasecmp(section, "Switches") != 0
+        ) {
+            error = "Scopes apply to keys and switches only!";
+        } else if((error = config_limit(new, key, &limit)) != NULL) {
+            /* invalid options in parentheses after the event */
+        } else if(
+            limit != NULL && limit->repeat && strcasecmp(section, "Keys") != 0
+        ) {
+            error = "Repeat applies to keys only!";
+        } else if(
+            limit != NULL && limit->gesture != GESTURE_PRESS &&
+            strcasecmp(section, "Keys") != 0
+        ) {
+            error = "Gestures apply to keys only!";
+        } else if(
+            limit != NULL && limit->gesture != GESTURE_PRESS && limit->repeat
+        ) {
+            error = "Conflicting options!";
+        } else if(
+            limit != NULL && limit->hysteresis &&
+            strcasecmp(section, "Absolute") != 0
+        ) {
+            error = "Hysteresis applies to absolute axes only!";
+        } else if(
+            limit != NULL && limit->timeout_us &&
+            strcasecmp(section, "Sequences") != 0
+        ) {
+            error = "Timeout applies to sequences only!";
+        } else if(strcasecmp(section, "Keys") == 0) {
+            if((error = config_key_event(new, key, value, limit,
+                scope)) == NULL) {
+                new->repeat_n += (limit != NULL && limit->repeat);
+            }
+        } else if(strcasecmp(section, "Sequences") == 0) {
+            error = config_sequence_event(new, key, value, limit);
+        } else if(strcasecmp(section, "Idle") == 0) {
+            if((error = config_idle_event(new, key, value)) == NULL) {
+                new->idle_events[new->idle_event_n-1].exec.limit = limit;
+            }
+        } else if(strcasecmp(section, "Switches") == 0) {
+            if((error = config_switch_event(new, key, value)) == NULL) {
+                new->switch_events[new->switch_event_n-1].exec.limit = limit;
+                new->switch_events[new->switch_event_n-1].scope = scope;
+            }
+        } else if(strcasecmp(section, "Relative") == 0) {
+            if((error = config_axis_event(new, EV_REL, key, value)) == NULL) {
+                new->axis_events[new->axis_event_n-1].exec.limit = limit;
+            }
+        } else if(strcasecmp(section, "Absolute") == 0) {
+            if((error = config_axis_event(new, EV_ABS, key, value)) == NULL) {
+                new->axis_events[new->axis_event_n-1].exec.limit = limit;
+            }
+        } else {
+            error = "Unknown section!";
+            section = NULL;
+        }
+
+        print_error:
+        if(error != NULL) {
+            new->error_n++;
+            fprintf(stderr, PROGRAM": %s (%s:%d)\n",
+                error, conf.configfile, line_num);
+        }
+
+
+    }
+
+    qsort(new->idle_events, new->idle_event_n, sizeof(idle_event_t),
+        (int (*)(const void *, const void *)) idle_event_compare);
+
+    qsort(new->switch_events, new->switch_event_n, sizeof(switch_event_t),
+        (int (*)(const void *, const void *)) switch_event_compare);
+
+    qsort(new->axis_events, new->axis_event_n, sizeof(axis_event_t),
+        (int (*)(const void *, const void *)) axis_event_compare);
+
+    if(section != NULL) {
+        free(section);
+    }
+
+    fclose(config_fd);
+
+    config_pack_bindings(new);
+
+    return new;
+}
+
+static void config_pack_bindings(bindings_t *new) {
+    /* move the tables next to their strings, sized to what was parsed */
+    new->key_events = arena_move(&new->arena, new->key_events,
+        new->key_event_n * sizeof(key_event_t));
+    new->key_event_table = arena_move(&new->arena, new->key_event_table,
+        new->key_event_table_size * sizeof(unsigned int));
+    new->sequence_events = arena_move(&new->arena, new->sequence_events,
+        new->sequence_event_n * sizeof(sequence_event_t));
+    new->sequence_event_table = arena_move(&new->arena,
+        new->sequence_event_table,
+        new->sequence_event_table_size * sizeof(unsigned int));
+    new->idle_events = arena_move(&new->arena, new->idle_events,
+        new->idle_event_n * sizeof(idle_event_t));
+    new->switch_events = arena_move(&new->arena, new->switch_events,
+        new->switch_event_n * sizeof(switch_event_t));
+    new->axis_events = arena_move(&new->arena, new->axis_events,
+        new->axis_event_n * sizeof(axis_event_t));
+    new->listen = arena_move(&new->arena, new->listen,
+        new->listen_n * sizeof(listen_t));
+    new->devices = arena_move(&new->arena, new->devices,
+        new->device_n * sizeof(device_t));
+
+    new->key_event_max = new->key_event_n;
+    new->sequence_event_max = new->sequence_event_n;
+    new->idle_event_max = new->idle_event_n;
+    new->switch_event_max = new->switch_event_n;
+    new->axis_event_max = new->axis_event_n;
+    new->listen_max = new->listen_n;
+    new->device_max = new->device_n;
+}
+
+static void config_free_bindings(bindings_t *old) {
+    arena_t arena = old->arena;
+
+    if(old->mapping != NULL) {
+        munmap(old->mapping, old->mapping_size);
+        return;
+    }
+
+    /* the bindings themselves live in the arena as well */
+    arena_free(&arena);
+}
+
+static bindings_t *config_load() {
+    bindings_t *new;
+    struct stat st;
+
+    if(conf.cachefile == NULL) {
+        return config_parse_file();
+    }
+
+    if(stat(conf.configfile, &st) < 0) {
+        fprintf(stderr, PROGRAM": stat(%s): %s\n",
+            conf.configfile, strerror(errno));
+        return NULL;
+    }
+
+    if((new = config_cache_read(conf.cachefile, &st)) != NULL) {
+        return new;
+    }
+
+    if((new = config_parse_file()) == NULL) {
+        return NULL;
+    }
+
+    /* a configuration with errors is parsed again, to report them again */
+    if(new->error_n == 0) {
+        config_cache_write(conf.cachefile, &st, new);
+    }
+
+    return new;
+}
+
+static bindings_t *config_cache_read(const char *path, const struct stat *st) {
+    cache_header_t *header;
+    struct stat cache_st;
+    bindings_t *new;
+    void *mapping;
+    int fd;
+
+    if((fd = open(path, O_RDONLY | O_CLOEXEC)) < 0) {
+        return NULL;
+    }
+
+    if(fstat(fd, &cache_st) < 0 || cache_st.st_size < CACHE_DATA) {
+        close(fd);
+        return NULL;
+    }
+
+    /* private mapping, the bindings keep their runtime state in it */
+    mapping = mmap(NULL, cache_st.st_size, PROT_READ | PROT_WRITE,
+        MAP_PRIVATE, fd, 0);
+    close(fd);
+
+    if(mapping == MAP_FAILED) {
+        return NULL;
+    }
+
+    header = mapping;
+    if(
+        memcmp(header->magic, CACHE_MAGIC, sizeof(header->magic)) != 0 ||
+        header->layout != CACHE_LAYOUT ||
+        header->size != cache_st.st_size - CACHE_DATA ||
+        header->config_size != st->st_size ||
+        header->config_ino != st->st_ino ||
+        header->config_mtime_sec != st->st_mtim.tv_sec ||
+        header->config_mtime_nsec != st->st_mtim.tv_nsec ||
+        config_cache_check((char *) mapping + CACHE_DATA, header->size) < 0
+    ) {
+        if(conf.verbose) {
+            fprintf(stderr, PROGRAM": ignoring %s\n", path);
+        }
+        munmap(mapping, cache_st.st_size);
+        return NULL;
+    }
+
+    new = (bindings_t *) ((char *) mapping + CACHE_DATA);
+    config_cache_relocate(new, (intptr_t) new);
+
+    new->arena.head = NULL;
+    new->mapping = mapping;
+    new->mapping_size = cache_st.st_size;
+
+    if(conf.verbose) {
+        fprintf(stderr, PROGRAM": using %s\n", path);
+    }
+
+    return new;
+}
+
+static void
+config_cache_write(const char *path, const struct stat *st,
+    const bindings_t *bindings) {
+    cache_header_t header;
+    arena_t arena = { NULL };
+    arena_block_t *block;
+    bindings_t *copy;
+    size_t size = 0, i;
+    char tmpfile[PATH_MAX + 4];
+    FILE *cache;
+
+    for(block = bindings->arena.head; block != NULL; block = block->next) {
+        size += block->used;
+    }
+
+    /* one block, so offsets from its start replace all pointers */
+    arena_alloc(&arena, size + ARENA_ALIGN);
+    arena.head->used = 0;
+
+    copy = arena_memdup(&arena, bindings, sizeof(bindings_t));
+    copy->arena.head = NULL;
+
+    copy->key_events = arena_memdup(&arena, bindings->key_events,
+        bindings->key_event_n * sizeof(key_event_t));
+    copy->key_event_table = arena_memdup(&arena, bindings->key_event_table,
+        bindings->key_event_table_size * sizeof(unsigned int));
+    copy->sequence_events = arena_memdup(&arena, bindings->sequence_events,
+        bindings->sequence_event_n * sizeof(sequence_event_t));
+    copy->sequence_event_table = arena_memdup(&arena,
+        bindings->sequence_event_table,
+        bindings->sequence_event_table_size * sizeof(unsigned int));
+    copy->idle_events = arena_memdup(&arena, bindings->idle_events,
+        bindings->idle_event_n * sizeof(idle_event_t));
+    copy->switch_events = arena_memdup(&arena, bindings->switch_events,
+        bindings->switch_event_n * sizeof(switch_event_t));
+    copy->axis_events = arena_memdup(&arena, bindings->axis_events,
+        bindings->axis_event_n * sizeof(axis_event_t));
+    copy->listen = arena_memdup(&arena, bindings->listen,
+        bindings->listen_n * sizeof(listen_t));
+    copy->devices = arena_memdup(&arena, bindings->devices,
+        bindings->device_n * sizeof(device_t));
+
+    for(i=0; i < bindings->key_event_n; i++) {
+        config_cache_command(&arena, &copy->key_events[i].exec);
+    }
+    for(i=0; i < bindings->sequence_event_n; i++) {
+        /* inner nodes have no command */
+        if(copy->sequence_events[i].step.exec.line != NULL) {
+            config_cache_command(&arena, &copy->sequence_events[i].step.exec);
+        }
+    }
+    for(i=0; i < bindings->idle_event_n; i++) {
+        config_cache_command(&arena, &copy->idle_events[i].exec);
+    }
+    for(i=0; i < bindings->switch_event_n; i++) {
+        config_cache_command(&arena, &copy->switch_events[i].exec);
+    }
+    for(i=0; i < bindings->axis_event_n; i++) {
+        config_cache_command(&arena, &copy->axis_events[i].exec);
+    }
+    for(i=0; i < bindings->listen_n; i++) {
+        copy->listen[i].path = arena_strdup(&arena, copy->listen[i].path);
+    }
+    for(i=0; i < bindings->device_n; i++) {
+        device_t *device = &copy->devices[i];
+
+        device->label = arena_strdup(&arena, device->label);
+        if(device->name != NULL) {
+            device->name = arena_strdup(&arena, device->name);
+        }
+        if(device->phys != NULL) {
+            device->phys = arena_strdup(&arena, device->phys);
+        }
+    }
+    if(copy->stats_file != NULL) {
+        copy->stats_file = arena_strdup(&arena, copy->stats_file);
+    }
+
+    /* the copy holds no more than the arena it was made from */
+    if(arena.head->next != NULL) {
+        arena_free(&arena);
+        return;
+    }
+
+    config_cache_relocate(copy, -(intptr_t) copy);
+
+    memset(&header, 0, sizeof(header));
+    memcpy(header.magic, CACHE_MAGIC, sizeof(header.magic));
+    header.layout            = CACHE_LAYOUT;
+    header.size              = arena.head->used;
+    header.config_size       = st->st_size;
+    header.config_ino        = st->st_ino;
+    header.config_mtime_sec  = st->st_mtim.tv_sec;
+    header.config_mtime_nsec = st->st_mtim.tv_nsec;
+
+    /* replaced atomically, a concurrent start never maps a partial file */
+    snprintf(tmpfile, sizeof(tmpfile), "%s.tmp", path);
+    if((cache = fopen(tmpfile, "w")) != NULL) {
+        fwrite(&header, sizeof(header), 1, cache);
+        fseek(cache, CACHE_DATA, SEEK_SET);
+        fwrite(arena.head->data, arena.head->used, 1, cache);
+
+        if(fclose(cache) != 0 || rename(tmpfile, path) < 0) {
+            unlink(tmpfile);
+        }
+    } else if(conf.verbose) {
+        /* a read-only directory just means parsing every time */
+        fprintf(stderr, PROGRAM": fopen(%s): %s\n", tmpfile, strerror(errno));
+    }
+
+    arena_free(&arena);
+}
+
+static void config_cache_command(arena_t *arena, command_t *command) {
+    size_t argc;
+    char *buffer;
+
+    command->line = arena_strdup(arena, command->line);
+
+    if(command->argv != NULL) {
+        for(argc=0; command->argv[argc] != NULL; argc++);
+
+        command->argv = arena_memdup(arena, command->argv,
+            (argc + 1) * sizeof(char *));
+
+        /* the words share one buffer, see config_command() */
+        buffer = arena_memdup(arena, command->argv[0],
+            command->argv[argc-1] + strlen(command->argv[argc-1]) + 1 -
+            command->argv[0]);
+        for(argc--; argc > 0; argc--) {
+            command->argv[argc] = buffer + (command->argv[argc] -
+                command->argv[0]);
+        }
+        command->argv[0] = buffer;
+    }
+
+    if(command->limit != NULL) {
+        command->limit = arena_memdup(arena, command->limit, sizeof(limit_t));
+    }
+
+    if(command->builtin != NULL) {
+        builtin_t *builtin = arena_memdup(arena, command->builtin,
+            sizeof(builtin_t));
+
+        if(builtin->path != NULL) {
+            builtin->path = arena_strdup(arena, builtin->path);
+        }
+        if(builtin->data != NULL) {
+            builtin->data = arena_memdup(arena, builtin->data,
+                builtin->length);
+        }
+        command->builtin = builtin;
+    }
+}
+
+/* offsets of 'n' elements or a string, 0 being NULL, within the copy */
+#define CACHE_FITS(ptr, n, size) \
+    ((uintptr_t) (ptr) <= (size) && \
+     (n) <= ((size) - (uintptr_t) (ptr)) / sizeof(*(ptr)))
+#define CACHE_STRING(base, ptr, size) \
+    ((ptr) == NULL || ((uintptr_t) (ptr) < (size) && \
+     memchr((base) + (uintptr_t) (ptr), '\0', (size) - (uintptr_t) (ptr))))
+
+static int config_cache_check(const char *base, size_t size) {
+    const bindings_t *b = (const bindings_t *) base;
+    const unsigned int *table;
+    const device_t *devices;
+    const listen_t *listen;
+    size_t i;
+
+    if(size < sizeof(bindings_t)) {
+        return -1;
+    }
+
+    /* sizes the latches of every listener, see axis_state_t */
+    if(b->axis_event_n > MAX_AXIS_EVENTS) {
+        return -1;
+    }
+
+    if(
+        !CACHE_FITS(b->key_events, b->key_event_n, size) ||
+        !CACHE_FITS(b->key_event_table, b->key_event_table_size, size) ||
+        !CACHE_FITS(b->sequence_events, b->sequence_event_n, size) ||
+        !CACHE_FITS(b->sequence_event_table, b->sequence_event_table_size,
+            size) ||
+        !CACHE_FITS(b->idle_events, b->idle_event_n, size) ||
+        !CACHE_FITS(b->switch_events, b->switch_event_n, size) ||
+        !CACHE_FITS(b->axis_events, b->axis_event_n, size) ||
+        !CACHE_FITS(b->listen, b->listen_n, size) ||
+        !CACHE_FITS(b->devices, b->device_n, size) ||
+        !CACHE_STRING(base, b->stats_file, size)
+    ) {
+        return -1;
+    }
+
+    /* the hash tables are walked with a mask up to an empty slot */
+    table = (const unsigned int *) (base + (uintptr_t) b->key_event_table);
+    if(config_cache_check_table(table, b->key_event_table_size,
+        b->key_event_n) < 0
+    ) {
+        return -1;
+    }
+    table = (const unsigned int *)
+        (base + (uintptr_t) b->sequence_event_table);
+    if(config_cache_check_table(table, b->sequence_event_table_size,
+        b->sequence_event_n) < 0
+    ) {
+        return -1;
+    }
+
+    for(i=0; i < b->key_event_n; i++) {
+        const key_event_t *event = (const key_event_t *)
+            (base + (uintptr_t) b->key_events) + i;
+
+        if(
+            config_cache_check_key(b, event) < 0 ||
+            config_cache_check_command(base, size, &event->exec) < 0
+        ) {
+            return -1;
+        }
+    }
+    for(i=0; i < b->sequence_event_n; i++) {
+        const sequence_event_t *event = (const sequence_event_t *)
+            (base + (uintptr_t) b->sequence_events) + i;
+
+        /* parents come first, so walking up always ends */
+        if(
+            event->parent > i ||
+            config_cache_check_key(b, &event->step) < 0 ||
+            config_cache_check_command(base, size, &event->step.exec) < 0
+        ) {
+            return -1;
+        }
+    }
+    for(i=0; i < b->idle_event_n; i++) {
+        const idle_event_t *event = (const idle_event_t *)
+            (base + (uintptr_t) b->idle_events) + i;
+
+        if(config_cache_check_command(base, size, &event->exec) < 0) {
+            return -1;
+        }
+    }
+    for(i=0; i < b->switch_event_n; i++) {
+        const switch_event_t *event = (const switch_event_t *)
+            (base + (uintptr_t) b->switch_events) + i;
+
+        if(
+            event->code < 0 || event->code >= SW_CNT ||
+            event->scope > b->device_n ||
+            config_cache_check_command(base, size, &event->exec) < 0
+        ) {
+            return -1;
+        }
+    }
+    for(i=0; i < b->axis_event_n; i++) {
+        const axis_event_t *event = (const axis_event_t *)
+            (base + (uintptr_t) b->axis_events) + i;
+
+        if(
+            (event->type == EV_REL ? event->code >= REL_CNT :
+                event->type != EV_ABS || event->code >= ABS_CNT) ||
+            config_cache_check_command(base, size, &event->exec) < 0
+        ) {
+            return -1;
+        }
+    }
+
+    listen = (const listen_t *) (base + (uintptr_t) b->listen);
+    for(i=0; i < b->listen_n; i++) {
+        if(!CACHE_STRING(base, listen[i].path, size)) {
+            return -1;
+        }
+    }
+    devices = (const device_t *) (base + (uintptr_t) b->devices);
+    for(i=0; i < b->device_n; i++) {
+        if(
+            devices[i].label == NULL ||
+            !CACHE_STRING(base, devices[i].label, size) ||
+            !CACHE_STRING(base, devices[i].name, size) ||
+            !CACHE_STRING(base, devices[i].phys, size)
+        ) {
+            return -1;
+        }
+    }
+
+    return 0;
+}
+
+static int
+config_cache_check_table(const unsigned int *table, size_t size, size_t n) {
+    size_t i, empty = 0;
+
+    if(size == 0) {
+        return 0;
+    }
+    if((size & (size - 1)) != 0) {
+        return -1;
+    }
+
+    /* entries are indexes plus one */
+    for(i=0; i < size; i++) {
+        if(table[i] > n) {
+            return -1;
+        }
+        empty += (table[i] == 0);
+    }
+
+    return (empty > 0) ? 0 : -1;
+}
+
+static int
+config_cache_check_key(const bindings_t *b, const key_event_t *event) {
+    size_t i;
+
+    if(
+        event->code >= KEY_CNT || event->gesture >= GESTURES ||
+        event->scope > b->device_n || event->modifier_n > MAX_MODIFIERS
+    ) {
+        return -1;
+    }
+    for(i=0; i < event->modifier_n; i++) {
+        if(event->modifiers[i] >= KEY_CNT) {
+            return -1;
+        }
+    }
+
+    return 0;
+}
+
+static int
+config_cache_check_command(const char *base, size_t size,
+    const command_t *command) {
+    const builtin_t *builtin;
+    const limit_t *limit;
+    char * const *argv;
+    size_t argc;
+
+    if(
+        !CACHE_STRING(base, command->line, size) ||
+        !CACHE_FITS(command->limit, 1, size) ||
+        !CACHE_FITS(command->builtin, 1, size) ||
+        !CACHE_FITS(command->argv, 1, size)
+    ) {
+        return -1;
+    }
+
+    if(command->limit != NULL) {
+        limit = (const limit_t *) (base + (uintptr_t) command->limit);
+
+        if(limit->gesture >= GESTURES) {
+            return -1;
+        }
+    }
+
+    /* codes are used as bit and table indexes */
+    if(command->builtin != NULL) {
+        builtin = (const builtin_t *) (base + (uintptr_t) command->builtin);
+
+        if(
+            (builtin->type == BUILTIN_EMIT && builtin->code >= KEY_CNT) ||
+            (builtin->type == BUILTIN_LED && builtin->code >= LED_CNT) ||
+            !CACHE_STRING(base, builtin->path, size) ||
+            !CACHE_FITS((const char *) builtin->data, builtin->length, size)
+        ) {
+            return -1;
+        }
+    }
+
+    /* argv ends with NULL before the end of the copy */
+    if(command->argv != NULL) {
+        argv = (char * const *) (base + (uintptr_t) command->argv);
+
+        for(argc=0; ; argc++) {
+            if(!CACHE_FITS(command->argv, argc + 1, size)) {
+                return -1;
+            }
+            if(argv[argc] == NULL) {
+                break;
+            }
+            if(!CACHE_STRING(base, argv[argc], size)) {
+                return -1;
+            }
+        }
+    }
+
+    return 0;
+}
+
+#define RELOCATE(ptr, delta) \
+    ((ptr) = (ptr) ? (void *) ((intptr_t) (ptr) + (delta)) : NULL)
+
+static void config_cache_relocate_command(command_t *command, intptr_t delta) {
+    size_t argc;
+
+    RELOCATE(command->line, delta);
+    RELOCATE(command->limit, delta);
+
+    /* entries are relocated after the array when loading, before otherwise */
+    if(delta > 0) {
+        RELOCATE(command->builtin, delta);
+        RELOCATE(command->argv, delta);
+    }
+    if(command->builtin != NULL) {
+        RELOCATE(command->builtin->path, delta);
+        RELOCATE(command->builtin->data, delta);
+    }
+    for(argc=0; command->argv != NULL && command->argv[argc] != NULL; argc++) {
+        RELOCATE(command->argv[argc], delta);
+    }
+    if(delta < 0) {
+        RELOCATE(command->builtin, delta);
+        RELOCATE(command->argv, delta);
+    }
+}
+
+static void config_cache_relocate(bindings_t *b, intptr_t delta) {
+    size_t i;
+
+    /* arrays are relocated before their entries when loading */
+    if(delta > 0) {
+        RELOCATE(b->key_events, delta);
+        RELOCATE(b->key_event_table, delta);
+        RELOCATE(b->sequence_events, delta);
+        RELOCATE(b->sequence_event_table, delta);
+        RELOCATE(b->idle_events, delta);
+        RELOCATE(b->switch_events, delta);
+        RELOCATE(b->axis_events, delta);
+        RELOCATE(b->listen, delta);
+        RELOCATE(b->devices, delta);
+    }
+
+    for(i=0; i < b->key_event_n; i++) {
+        config_cache_relocate_command(&b->key_events[i].exec, delta);
+    }
+    for(i=0; i < b->sequence_event_n; i++) {
+        config_cache_relocate_command(&b->sequence_events[i].step.exec, delta);
+    }
+    for(i=0; i < b->idle_event_n; i++) {
+        config_cache_relocate_command(&b->idle_events[i].exec, delta);
+    }
+    for(i=0; i < b->switch_event_n; i++) {
+        config_cache_relocate_command(&b->switch_events[i].exec, delta);
+    }
+    for(i=0; i < b->axis_event_n; i++) {
+        config_cache_relocate_command(&b->axis_events[i].exec, delta);
+    }
+    for(i=0; i < b->listen_n; i++) {
+        RELOCATE(b->listen[i].path, delta);
+    }
+    for(i=0; i < b->device_n; i++) {
+        RELOCATE(b->devices[i].label, delta);
+        RELOCATE(b->devices[i].name, delta);
+        RELOCATE(b->devices[i].phys, delta);
+    }
+    RELOCATE(b->stats_file, delta);
+
+    if(delta < 0) {
+        RELOCATE(b->key_events, delta);
+        RELOCATE(b->key_event_table, delta);
+        RELOCATE(b->sequence_events, delta);
+        RELOCATE(b->sequence_event_table, delta);
+        RELOCATE(b->idle_events, delta);
+        RELOCATE(b->switch_events, delta);
+        RELOCATE(b->axis_events, delta);
+        RELOCATE(b->listen, delta);
+        RELOCATE(b->devices, delta);
+    }
+}
+
+static void *config_grow(void *array, size_t n, size_t *max, size_t size) {
+    if(n < *max) {
+        return array;
+    }
+
+    *max = (*max > 0) ? *max * 2 : 16;
+    if((array = realloc(array, *max * size)) == NULL) {
+        perror(PROGRAM": realloc()");
+        exit(EXIT_FAILURE);
+    }
+
+    return array;
+}
+
+static const char *config_key_chord(char *shortcut, key_event_t *new_key_event) {
+    int i, j, code;
+    char *name, *modifier;
+
+    memset(new_key_event, 0, sizeof(key_event_t));
+
+    if((name = strrchr(shortcut, '+')) != NULL) {
+        *name = '\0';
+        name = config_trim_string(name+1);
+
+        modifier = strtok(shortcut, "+");
+        while(modifier != NULL) {
+            modifier = config_trim_string(modifier);
+
+            if(strcasecmp(modifier, "CTRL") == 0) {
+                new_key_event->modifier_mask |= MODIFIER_CTRL;
+            } else if(strcasecmp(modifier, "ALT") == 0) {
+                new_key_event->modifier_mask |= MODIFIER_ALT;
+            } else if(strcasecmp(modifier, "SHIFT") == 0) {
+                new_key_event->modifier_mask |= MODIFIER_SHIFT;
+            } else if(strcasecmp(modifier, "META") == 0) {
+                new_key_event->modifier_mask |= MODIFIER_META;
+            } else if((code = key_event_code(modifier)) < 0) {
+                return "Unknown modifier!";
+            } else if(key_event_modifier(code)) {
+                new_key_event->modifier_mask |= key_event_modifier(code);
+            } else if(new_key_event->modifier_n < MAX_MODIFIERS) {
+                /* insert sorted, ignoring duplicates */
+                for(i=0; i < new_key_event->modifier_n &&
+                    new_key_event->modifiers[i] < code; i++);
+
+                if(i == new_key_event->modifier_n ||
+                    new_key_event->modifiers[i] != code
+                ) {
+                    for(j=new_key_event->modifier_n; j > i; j--) {
+                        new_key_event->modifiers[j] =
+                            new_key_event->modifiers[j-1];
+                    }
+                    new_key_event->modifiers[i] = code;
+                    new_key_event->modifier_n++;
+                }
+            } else {
+                return "Modifier limit exceeded!";
+            }
+
+            modifier = strtok(NULL, "+");
+        }
+
+        if(
+            __builtin_popcount(new_key_event->modifier_mask) +
+                new_key_event->modifier_n > MAX_MODIFIERS
+        ) {
+            return "Modifier limit exceeded!";
+        }
+    } else {
+        name = shortcut;
+    }
+
+    if((code = key_event_code(name)) < 0) {
+        return "Unknown key!";
+    }
+    new_key_event->code = code;
+
+    return NULL;
+}
+
+static const char *
+config_key_event(bindings_t *new, char *shortcut, char *exec, limit_t *limit,
+    unsigned int scope) {
+    const char *error;
+    key_event_t *new_key_event;
+
+    new->key_events = config_grow(new->key_events, new->key_event_n,
+        &new->key_event_max, sizeof(key_event_t));
+    new_key_event = &new->key_events[new->key_event_n];
+
+    if((error = config_key_chord(shortcut, new_key_event))) {
+        return error;
+    }
+
+    /* gestures are told apart by the timing of one key, not of a chord */
+    if(limit != NULL && limit->gesture != GESTURE_PRESS) {
+        if(new_key_event->modifier_mask != 0 || new_key_event->modifier_n > 0) {
+            return "Gestures apply to single keys only!";
+        }
+        new_key_event->gesture = limit->gesture;
+    }
+    new_key_event->scope = scope;
+
+    if((error = config_command(&new->arena, &new_key_event->exec, exec))) {
+        return error;
+    }
+
+    new_key_event->exec.limit = limit;
+
+    if(key_event_insert(new, new->key_event_n) < 0) {
+        return "Shortcut already defined!";
+    }
+    if(new_key_event->gesture != GESTURE_PRESS) {
+        set_bit(new->gesture_keys, new_key_event->code);
+        new->gesture_n++;
+    }
+    new->key_event_n++;
+
+    return NULL;
+}
+
+static const char *
+config_sequence_event(bindings_t *new, char *sequence, char *exec,
+    limit_t *limit) {
+    key_event_t steps[MAX_STEPS];
+    sequence_event_t *node;
+    command_t command;
+    unsigned long long timeout_us;
+    unsigned int parent = 0, next;
+    size_t i, step_n = 0;
+    const char *error;
+    char *step;
+
+    /* config_key_chord() uses strtok() itself */
+    while((step = strsep(&sequence, ",")) != NULL) {
+        if(step_n == MAX_STEPS) {
+            return "Step limit exceeded!";
+        }
+        step = config_trim_string(step);
+        if((error = config_key_chord(step, &steps[step_n]))) {
+            return error;
+        }
+
+        /* a modifier on its own only starts the next chord */
+        if(
+            steps[step_n].modifier_mask == 0 && steps[step_n].modifier_n == 0 &&
+            key_event_modifier(steps[step_n].code)
+        ) {
+            return "Invalid sequence!";
+        }
+        step_n++;
+    }
+
+    if(step_n < 2) {
+        return "Invalid sequence!";
+    }
+
+    /* follow the shared prefix, a sequence may not end inside another one */
+    for(i=0; i < step_n; i++) {
+        if((next = sequence_event_lookup(new, parent, &steps[i])) == 0) {
+            break;
+        }
+        if(
+            i+1 < step_n &&
+            new->sequence_events[next-1].step.exec.line != NULL
+        ) {
+            return "Sequence prefix already defined!";
+        }
+        parent = next;
+    }
+    if(i == step_n) {
+        return "Sequence already defined!";
+    }
+
+    if((error = config_command(&new->arena, &command, exec))) {
+        return error;
+    }
+    command.limit = limit;
+
+    timeout_us = (limit != NULL && limit->timeout_us) ?
+        limit->timeout_us : SEQUENCE_TIMEOUT;
+
+    for(; i < step_n; i++) {
+        new->sequence_events = config_grow(new->sequence_events,
+            new->sequence_event_n, &new->sequence_event_max,
+            sizeof(sequence_event_t));
+        node = &new->sequence_events[new->sequence_event_n++];
+
+        node->parent = parent;
+        node->children = 0;
+        node->timeout_us = 0;
+        node->step = steps[i];
+
+        if(parent != 0) {
+            new->sequence_events[parent-1].children++;
+        }
+        sequence_event_insert(new, new->sequence_event_n);
+        parent = new->sequence_event_n;
+    }
+
+    node = &new->sequence_events[parent-1];
+    node->step.exec = command;
+
+    /* the steps before the last wait for the longest following timeout */
+    for(next = node->parent; next != 0;
+        next = new->sequence_events[next-1].parent
+    ) {
+        if(new->sequence_events[next-1].timeout_us < timeout_us) {
+            new->sequence_events[next-1].timeout_us = timeout_us;
+        }
+    }
+
+    return NULL;
+}
+
+static const char *
+config_idle_event(bindings_t *new, char *timeout, char *exec) {
+    idle_event_t *new_idle_event;
+    const char *error;
+    unsigned long count;
+    char *unit;
+
+    new->idle_events = config_grow(new->idle_events, new->idle_event_n,
+        &new->idle_event_max, sizeof(idle_event_t));
+    new_idle_event = &new->idle_events[new->idle_event_n++];
+
+    new_idle_event->timeout = 0;
+    if((error = config_command(&new->arena, &new_idle_event->exec, exec))) {
+        new->idle_event_n--;
+        return error;
+    }
+
+    if(strcasecmp(timeout, "RESET") == 0) {
+        new_idle_event->timeout = IDLE_RESET;
+        return NULL;
+    }
+
+    while(*timeout) {
+        while(*timeout && !isdigit(*timeout)) timeout++;
+        count = strtoul(timeout, &unit, 10);
+
+        switch(*unit) {
+        case 'h':
+            new_idle_event->timeout += count * 3600;
+            break;
+        case 'm':
+            new_idle_event->timeout += count * 60;
+            break;
+        case 's':
+        default:
+            new_idle_event->timeout += count;
+            break;
+        }
+
+        timeout = unit;
+    }
+
+    return NULL;
+}
+
+static const char *
+config_switch_event(bindings_t *new, char *switchcode, char *exec) {
+    char *code, *value;
+    const char *error;
+    switch_event_t *new_switch_event;
+
+    new->switch_events = config_grow(new->switch_events, new->switch_event_n,
+        &new->switch_event_max, sizeof(switch_event_t));
+    new_switch_event = &new->switch_events[new->switch_event_n++];
+
+    code = value = switchcode;
+    strsep(&value, ":");
+    if(value == NULL) {
+        new->switch_event_n--;
+        return "Invalid switch identifier";
+    }
+
+    code = config_trim_string(code);
+    value = config_trim_string(value);
+
+    if((new_switch_event->code = switch_event_code(code)) < 0) {
+        new->switch_event_n--;
+        return "Unknown switch!";
+    }
+    new_switch_event->value = atoi(value);
+    if((error = config_command(&new->arena, &new_switch_event->exec, exec))) {
+        new->switch_event_n--;
+        return error;
+    }
+
+    return NULL;
+}
+
+static const char *
+config_axis_event(bindings_t *new, unsigned int type, char *axis, char *exec) {
+    char *name, *threshold, *end;
+    const char *error;
+    axis_event_t *new_axis_event;
+    long value;
+    int code;
+
+    /* each listener keeps a fixed bitmap of them, see axis_state_t */
+    if(new->axis_event_n >= MAX_AXIS_EVENTS) {
+        return "Too many axis bindings!";
+    }
+
+    new->axis_events = config_grow(new->axis_events, new->axis_event_n,
+        &new->axis_event_max, sizeof(axis_event_t));
+    new_axis_event = &new->axis_events[new->axis_event_n];
+
+    memset(new_axis_event, 0, sizeof(axis_event_t));
+
+    name = threshold = axis;
+    strsep(&threshold, ":");
+    if(threshold == NULL) {
+        return "Invalid axis identifier";
+    }
+
+    name = config_trim_string(name);
+    threshold = config_trim_string(threshold);
+
+    if((code = axis_event_code(type, name)) < 0) {
+        return "Unknown axis!";
+    }
+
+    /* relative: signed delta per report, absolute: '>' or '<' a value */
+    if(type == EV_ABS) {
+        if(*threshold == '<') {
+            new_axis_event->below = 1;
+        } else if(*threshold != '>') {
+            return "Invalid threshold!";
+        }
+        threshold = config_trim_string(threshold+1);
+    } else if(*threshold != '+' && *threshold != '-') {
+        return "Invalid threshold!";
+    }
+
+    value = strtol(threshold, &end, 10);
+    if(end == threshold || *end != '\0' || (type == EV_REL && value == 0)) {
+        return "Invalid threshold!";
+    }
+
+    new_axis_event->type = type;
+    new_axis_event->code = code;
+    new_axis_event->threshold = value;
+
+    if((error = config_command(&new->arena, &new_axis_event->exec, exec))) {
+        return error;
+    }
+
+    if(type == EV_REL) {
+        new->rel_mask |= 1u << code;
+    } else {
+        new->abs_mask |= 1ull << code;
+    }
+    new->axis_event_n++;
+
+    return NULL;
+}
+
+static const char *
+config_device(bindings_t *new, char *label, char *rules) {
+    static const struct {
+        const char      *name;
+        unsigned short  type;
+    } EVENT_TYPES[] = {
+        { "KEY", EV_KEY }, { "REL", EV_REL }, { "ABS", EV_ABS },
+        { "MSC", EV_MSC }, { "SW",  EV_SW  }, { "LED", EV_LED },
+        { "SND", EV_SND }, { "REP", EV_REP }, { "FF",  EV_FF  },
+    };
+    device_t *device;
+    char *rule, *value, *type, *end;
+    size_t i;
+
+    for(i=0; i < new->device_n; i++) {
+        if(strcmp(new->devices[i].label, label) == 0) {
+            return "Device already defined!";
+        }
+    }
+
+    new->devices = config_grow(new->devices, new->device_n,
+        &new->device_max, sizeof(device_t));
+    device = &new->devices[new->device_n];
+
+    memset(device, 0, sizeof(device_t));
+    device->vendor = device->product = -1;
+
+    /* 'name GLOB, phys GLOB, id VENDOR:PRODUCT, caps TYPE+TYPE, grab' */
+    while((rule = strsep(&rules, ",")) != NULL) {
+        value = config_trim_string(rule);
+        rule = strsep(&value, " \t");
+
+        if(strcasecmp(rule, "grab") == 0 && value == NULL) {
+            device->grab = 1;
+            continue;
+        } else if(value == NULL) {
+            return "Invalid device rule!";
+        }
+        value = config_trim_string(value);
+
+        /* globs may be quoted, to keep their spaces */
+        if(value[0] == '"' && strlen(value) > 1 &&
+            value[strlen(value)-1] == '"'
+        ) {
+            value[strlen(value)-1] = '\0';
+            value++;
+        }
+
+        if(strcasecmp(rule, "name") == 0) {
+            device->name = arena_strdup(&new->arena, value);
+        } else if(strcasecmp(rule, "phys") == 0) {
+            device->phys = arena_strdup(&new->arena, value);
+        } else if(strcasecmp(rule, "id") == 0) {
+            /* hexadecimal as in 'lsusb', '*' matches any */
+            if(strncmp(value, "*:", 2) != 0) {
+                device->vendor = strtol(value, &end, 16);
+                if(end == value || *end != ':') {
+                    return "Invalid device id!";
+                }
+            }
+            value = strchr(value, ':') + 1;
+            if(strcmp(value, "*") != 0) {
+                device->product = strtol(value, &end, 16);
+                if(end == value || *end != '\0') {
+                    return "Invalid device id!";
+                }
+            }
+        } else if(strcasecmp(rule, "caps") == 0) {
+            for(type = strtok(value, "+"); type; type = strtok(NULL, "+")) {
+                type = config_trim_string(type);
+                for(i=0; i < sizeof(EVENT_TYPES) / sizeof(EVENT_TYPES[0]) &&
+                    strcasecmp(EVENT_TYPES[i].name, type) != 0; i++);
+
+                if(i == sizeof(EVENT_TYPES) / sizeof(EVENT_TYPES[0])) {
+                    return "Unknown event type!";
+                }
+                device->caps |= 1u << EVENT_TYPES[i].type;
+            }
+        } else {
+            return "Unknown device rule!";
+        }
+    }
+
+    device->label = arena_strdup(&new->arena, label);
+    new->device_n++;
+
+    return NULL;
+}
+
+static const char *
+config_limit(bindings_t *new, char *key, limit_t **limit) {
+    char *options, *option, *value;
+    unsigned long long duration;
+
+    *limit = NULL;
+
+    if((options = strchr(key, '(')) == NULL) {
+        return NULL;
+    } else if(key[strlen(key)-1] != ')') {
+        return "Invalid options!";
+    }
+
+    *options++ = '\0';
+    options[strlen(options)-1] = '\0';
+    config_trim_string(key);
+
+    *limit = arena_alloc(&new->arena, sizeof(limit_t));
+    memset(*limit, 0, sizeof(limit_t));
+
+    for(option = strtok(options, ","); option; option = strtok(NULL, ",")) {
+        option = config_trim_string(option);
+        value = option;
+        strsep(&value, " \t");
+
+        if(strcasecmp(option, "drop") == 0 && value == NULL) {
+            (*limit)->coalesce = 0;
+        } else if(strcasecmp(option, "coalesce") == 0 && value == NULL) {
+            (*limit)->coalesce = 1;
+        } else if(strcasecmp(option, "repeat") == 0) {
+            (*limit)->repeat = 1;
+            if(
+                value != NULL &&
+                config_duration(config_trim_string(value), &duration) < 0
+            ) {
+                return "Invalid duration!";
+            }
+            (*limit)->repeat_us = (value != NULL) ? duration : 0;
+        } else if(
+            strcasecmp(option, "release") == 0 ||
+            strcasecmp(option, "hold") == 0 ||
+            strcasecmp(option, "double") == 0
+        ) {
+            if((*limit)->gesture != GESTURE_PRESS) {
+                return "Conflicting options!";
+            }
+            if(strcasecmp(option, "release") == 0) {
+                (*limit)->gesture = GESTURE_RELEASE;
+                duration = 0;
+            } else if(strcasecmp(option, "hold") == 0) {
+                (*limit)->gesture = GESTURE_HOLD;
+                duration = GESTURE_HOLD_US;
+            } else {
+                (*limit)->gesture = GESTURE_DOUBLE;
+                duration = GESTURE_DOUBLE_US;
+            }
+            if(
+                value != NULL && ((*limit)->gesture == GESTURE_RELEASE ||
+                config_duration(config_trim_string(value), &duration) < 0)
+            ) {
+                return "Invalid duration!";
+            }
+            (*limit)->gesture_us = duration;
+        } else if(value == NULL) {
+            return "Unknown option!";
+        } else if(strcasecmp(option, "hysteresis") == 0) {
+            if(((*limit)->hysteresis = atoi(value)) <= 0) {
+                return "Invalid hysteresis!";
+            }
+        } else if(strcasecmp(option, "max") == 0) {
+            (*limit)->max = strtoul(value, NULL, 10);
+        } else if(strcasecmp(option, "debounce") == 0) {
+            if(config_duration(config_trim_string(value), &duration) < 0) {
+                return "Invalid duration!";
+            }
+            (*limit)->debounce_us = duration;
+        } else if(strcasecmp(option, "timeout") == 0) {
+            if(
+                config_duration(config_trim_string(value), &duration) < 0 ||
+                duration == 0
+            ) {
+                return "Invalid duration!";
+            }
+            (*limit)->timeout_us = duration;
+        } else {
+            return "Unknown option!";
+        }
+    }
+
+    return NULL;
+}
+
+static int config_duration(const char *str, unsigned long long *us) {
+    unsigned long long count;
+    char *unit;
+
+    count = strtoull(str, &unit, 10);
+    if(unit == str) {
+        return -1;
+    }
+
+    /* plain numbers are milliseconds */
+    if(*unit == '\0' || strcmp(unit, "ms") == 0) {
+        *us = count * 1000;
+    } else if(strcmp(unit, "s") == 0) {
+        *us = count * 1000000;
+    } else if(strcmp(unit, "m") == 0) {
+        *us = count * 60000000;
+    } else {
+        return -1;
+    }
+
+    return 0;
+}
+
+static const char *
+config_command(arena_t *arena, command_t *command, const char *line) {
+    size_t argc = 0;
+    char *buffer, *ptr;
+
+    command->line = arena_strdup(arena, line);
+    command->argv = NULL;
+    command->limit = NULL;
+    command->builtin = NULL;
+
+    if(line[0] == '@') {
+        return config_builtin(arena, command, line+1);
+    }
+
+    /* anything beyond plain words needs the shell */
+    if(strpbrk(line, SHELL_CHARS) != NULL) {
+        return NULL;
+    }
+
+    buffer = arena_strdup(arena, line);
+    command->argv = arena_alloc(arena, (strlen(line)/2 + 2) * sizeof(char *));
+
+    for(ptr = strtok(buffer, " \t"); ptr != NULL; ptr = strtok(NULL, " \t")) {
+        command->argv[argc++] = ptr;
+    }
+    command->argv[argc] = NULL;
+
+    if(argc == 0) {
+        command->argv = NULL;
+    }
+
+    return NULL;
+}
+
+static const char *
+config_builtin(arena_t *arena, command_t *command, const char *line) {
+    builtin_t *builtin = arena_alloc(arena, sizeof(builtin_t));
+    char *buffer = arena_strdup(arena, line), *name, *arg, *rest;
+    int code;
+
+    memset(builtin, 0, sizeof(builtin_t));
+    command->builtin = builtin;
+
+    /* @name first [rest of the line] */
+    name = strtok(buffer, " \t");
+    arg  = strtok(NULL, " \t");
+    rest = strtok(NULL, "");
+
+    if(name == NULL || arg == NULL) {
+        return "Invalid builtin!";
+    }
+    if(rest != NULL) {
+        rest = config_trim_string(rest);
+    }
+
+    if(strcmp(name, "write") == 0 || strcmp(name, "send") == 0) {
+        if(rest == NULL) {
+            return "Missing value!";
+        }
+        builtin->type = (name[0] == 'w') ? BUILTIN_WRITE : BUILTIN_SEND;
+        builtin->path = arg;
+        builtin->length = strlen(rest) + 1;
+        builtin->data = memcpy(arena_alloc(arena, builtin->length + 1),
+            rest, builtin->length);
+        ((char *) builtin->data)[builtin->length - 1] = '\n';
+    } else if(strcmp(name, "emit") == 0) {
+        if((code = key_event_code(arg)) < 0) {
+            return "Unknown key!";
+        }
+        builtin->type = BUILTIN_EMIT;
+        builtin->code = code;
+        /* without a value the key is pressed and released */
+        builtin->value = (rest != NULL) ? atoi(rest) : -1;
+    } else if(strcmp(name, "led") == 0) {
+        for(code=0; code < LED_CNT; code++) {
+            if(LED_NAME[code] != NULL && strcasecmp(LED_NAME[code], arg) == 0) {
+                break;
+            }
+        }
+        if(code == LED_CNT) {
+            return "Unknown LED!";
+        }
+        builtin->type = BUILTIN_LED;
+        builtin->code = code;
+
+        if(rest == NULL || strcasecmp(rest, "toggle") == 0) {
+            builtin->value = -1;
+        } else if(strcasecmp(rest, "on") == 0) {
+            builtin->value = 1;
+        } else if(strcasecmp(rest, "off") == 0) {
+            builtin->value = 0;
+        } else {
+            return "Invalid LED state!";
+        }
+    } else {
+        return "Unknown builtin!";
+    }
+
+    return NULL;
+}
+
+static char *config_trim_string(char *str) {
+    char *end;
+
+    while(isspace(*str)) str++;
+
+    end = str + strlen(str) - 1;
+    while(end > str && isspace(*end)) end--;
+
+    *(end+1) = '\0';
+
+    return str;
+}
+
+static int config_code_compare(const void *name, const void *entry) {
+    return strcasecmp(name, ((const event_code_t *) entry)->name);
+}
+
+void daemon_init() {
+    conf.configfile  = "/etc/input-event-daemon.conf";
+    conf.cachefile   = NULL;
+
+    conf.monitor     = 0;
+    conf.verbose     = 0;
+    conf.daemon      = 1;
+
+    conf.read_count  = 0;
+    conf.event_count = 0;
+
+    conf.epoll_fd    = -1;
+    conf.inotify_fd  = -1;
+    conf.signal_fd   = -1;
+    conf.quit        = 0;
+    conf.timer_fd    = -1;
+    conf.monitor_fd  = -1;
+
+    conf.timer_deadline = 0;
+    conf.idle_last   = 0;
+    conf.input_last  = 0;
+    conf.idle_next   = 0;
+    conf.idle        = 0;
+    conf.listen_all  = 0;
+
+    conf.global_key_state = 0;
+    memset(&conf.key_state, 0, sizeof(key_state_t));
+    conf.watch       = NULL;
+    conf.watch_n     = 0;
+    conf.watch_max   = 0;
+
+    conf.exec_mode   = EXEC_DIRECT;
+    conf.helper_fd   = -1;
+    conf.helper_pid  = 0;
+    memset(conf.exec_stats, 0, sizeof(conf.exec_stats));
+    memset(&conf.dispatch, 0, sizeof(conf.dispatch));
+
+    conf.start_us       = daemon_monotonic_us();
+    conf.event_us       = 0;
+    conf.key_matched    = 0;
+    conf.sequence_matched = 0;
+    conf.switch_matched = 0;
+    conf.axis_matched   = 0;
+    conf.resync_count   = 0;
+    conf.idle_fired     = 0;
+    conf.exec_dropped   = 0;
+    conf.exec_deferred  = 0;
+
+    conf.children       = NULL;
+    conf.child_n        = 0;
+    conf.child_max      = 0;
+    conf.pending        = NULL;
+    conf.pending_n      = 0;
+    conf.pending_max    = 0;
+
+    conf.source         = NULL;
+    conf.uinput_fd      = -1;
+
+    conf.capture        = NULL;
+    conf.trace_devices  = 0;
+    conf.replay         = 0;
+
+    conf.listener     = NULL;
+    conf.listener_n   = 0;
+    conf.listener_max = 0;
+}
+
+void daemon_start_listener() {
+    int i, n, ready_n, fd_len;
+    unsigned char active;
+    struct epoll_event ready[EPOLL_BATCH];
+    struct termios monitoring_terminal;
+
+    signal(SIGPIPE, SIG_IGN);
+
+    /* nothing is spawned in monitoring mode, otherwise see daemon_exec_reap() */
+    if(conf.monitor) {
+        signal(SIGCHLD, SIG_IGN);
+    }
+
+    if((conf.epoll_fd = epoll_create1(EPOLL_CLOEXEC)) < 0) {
+        perror(PROGRAM": epoll_create1()");
         exit(EXIT_FAILURE);
     }
 
-    memset(buffer, 0, sizeof(buffer));
+    if(conf.monitor) {
+        monitor_init();
+    }
 
-    while(fgets(buffer, sizeof(buffer), config_fd) != NULL) {
-        line = config_trim_string(buffer);
-        line_num++;
+    if((conf.inotify_fd = inotify_init1(IN_NONBLOCK | IN_CLOEXEC)) < 0) {
+        perror(PROGRAM": inotify_init1()");
+    } else {
+        struct epoll_event ev = {
+            .events = EPOLLIN,
+            .data.ptr = &conf.inotify_fd
+        };
 
-        if(line[0] == '\0' || line[0] == '#') {
+        if(conf.listen_all || bindings->device_n > 0) {
+            input_watch_directory("/dev/input/event0");
+        }
+
+        epoll_ctl(conf.epoll_fd, EPOLL_CTL_ADD, conf.inotify_fd, &ev);
+    }
+
+    {
+        sigset_t signals;
+        struct epoll_event ev = {
+            .events = EPOLLIN,
+            .data.ptr = &conf.signal_fd
+        };
+
+        /* handled between event batches, e.g. never in the middle of
+         * daemon_reload(), and SIGTERM leaves through the event loop */
+        sigemptyset(&signals);
+        sigaddset(&signals, SIGTERM);
+        sigaddset(&signals, SIGINT);
+        if(!conf.monitor) {
+            sigaddset(&signals, SIGHUP);
+            sigaddset(&signals, SIGUSR1);
+            sigaddset(&signals, SIGCHLD);
+        }
+        sigprocmask(SIG_BLOCK, &signals, NULL);
+
+        if((conf.signal_fd = signalfd(-1, &signals,
+            SFD_NONBLOCK | SFD_CLOEXEC)) < 0
+        ) {
+            perror(PROGRAM": signalfd()");
+            sigprocmask(SIG_UNBLOCK, &signals, NULL);
+            /* let the kernel reap children, concurrency limits won't work */
+            signal(SIGCHLD, SIG_IGN);
+        } else {
+            epoll_ctl(conf.epoll_fd, EPOLL_CTL_ADD, conf.signal_fd, &ev);
+        }
+    }
+
+    if((conf.timer_fd = timerfd_create(CLOCK_MONOTONIC,
+        TFD_NONBLOCK | TFD_CLOEXEC)) < 0
+    ) {
+        perror(PROGRAM": timerfd_create()");
+        exit(EXIT_FAILURE);
+    } else {
+        struct epoll_event ev = {
+            .events = EPOLLIN,
+            .data.ptr = &conf.timer_fd
+        };
+
+        epoll_ctl(conf.epoll_fd, EPOLL_CTL_ADD, conf.timer_fd, &ev);
+    }
+
+    for(i=0; i < bindings->listen_n; i++) {
+        listener_t *listener = input_add_listener(bindings->listen[i].path);
+
+        if(listener != NULL) {
+            listener->grab = bindings->listen[i].grab;
+        }
+    }
+    input_match_all();
+
+    for(i=0, n=0, fd_len=0; i < conf.listener_n; i++) {
+        listener_t *listener = conf.listener[i];
+
+        if(listener->path == NULL) {
             continue;
         }
+        n++;
 
-        if((ptr = strchr(line, '#'))) {
-            *ptr = '\0';
+        if(conf.inotify_fd >= 0) {
+            input_watch_directory(listener->path);
         }
 
-        if(line[0] == '[' && line[strlen(line)-1] == ']') {
-            if(section != NULL) {
-                free(section);
+        /* missing devices are picked up once they appear */
+        if(input_open_listener(listener) < 0) {
+            fprintf(stderr, PROGRAM": open(%s): %s\n",
+                listener->path, strerror(errno));
+            continue;
+        }
+        fd_len++;
+    }
+
+    /* devices matching a rule may still be plugged in */
+    if(n == 0 && !conf.listen_all && bindings->device_n == 0) {
+        fprintf(stderr, PROGRAM": no listener found!\n");
+        return;
+    }
+
+    if(conf.verbose) {
+        fprintf(stderr, PROGRAM": Start listening on %d devices...\n", fd_len);
+    }
+
+    if(conf.monitor) {
+        if(conf.monitor == MONITOR_TEXT) {
+            monitor_printf(PROGRAM": Monitoring mode started. "
+                "Press CTRL+C to abort.\n\n");
+        }
+
+        /* get current terminal settings */
+        if(tcgetattr(STDIN_FILENO, &conf.terminal) < 0) {
+            perror(PROGRAM": tcgetattr()");
+            exit(EXIT_FAILURE);
+        }
+
+        /* disable echo on terminal */
+        monitoring_terminal = conf.terminal;
+        monitoring_terminal.c_lflag &= ~ECHO;
+
+        if(tcsetattr(STDIN_FILENO, TCSAFLUSH, &monitoring_terminal) < 0) {;
+            perror(PROGRAM": tcsetattr()");
+        }
+
+    } else if(conf.daemon) {
+        if(daemon(1, conf.verbose) < 0) {
+            perror(PROGRAM": daemon()");
+            exit(EXIT_FAILURE);
+        }
+    }
+
+    if(!conf.monitor) {
+        daemon_exec_init();
+    }
+
+    conf.idle_last = daemon_monotonic_us();
+    idle_event_schedule(conf.idle_last);
+    daemon_timer_arm(idle_event_deadline());
+
+    if(conf.monitor_len > 0) {
+        monitor_flush();
+    }
+
+    while(!conf.quit) {
+        ready_n = epoll_wait(conf.epoll_fd, ready, EPOLL_BATCH, -1);
+
+        if(ready_n < 0) {
+            if(errno == EINTR) {
+                continue;
             }
-            line[strlen(line)-1] = '\0';
-            section = config_trim_string(strdup(line+1));
+            perror(PROGRAM": epoll_wait()");
+            break;
+        }
+
+        for(i=0, active=0; i<ready_n; i++) {
+            listener_t *listener = ready[i].data.ptr;
+
+            if(ready[i].data.ptr == &conf.inotify_fd) {
+                input_hotplug();
+            } else if(ready[i].data.ptr == &conf.signal_fd) {
+                daemon_signal();
+            } else if(ready[i].data.ptr == &conf.timer_fd) {
+                daemon_timer_expired();
+            } else if(ready[i].data.ptr == &conf.monitor_fd) {
+                /* flushed below, unless nobody is reading any more */
+                if(ready[i].events & (EPOLLERR | EPOLLHUP)) {
+                    epoll_ctl(conf.epoll_fd, EPOLL_CTL_DEL, conf.monitor_fd,
+                        NULL);
+                    conf.monitor_polled = 0;
+                }
+            } else if(listener->fd < 0) {
+                /* closed earlier in this batch */
+                continue;
+            } else if((n = input_read_events(listener)) < 0) {
+                /* stop watching a device which went away */
+                input_close_listener(listener);
+            } else if(n > 0) {
+                active = 1;
+            }
+        }
+
+        if(active) {
+            idle_event_activity(conf.input_last);
+        }
+
+        /* one write per batch, not per event */
+        if(conf.monitor_len > 0) {
+            monitor_flush();
+        }
+    }
+}
+
+static void daemon_timer_arm(unsigned long long deadline) {
+    struct itimerspec spec = { .it_interval = { 0, 0 } };
+
+    /* an earlier expiry is fine, daemon_timer_expired() re-arms */
+    if(conf.timer_fd < 0 || deadline == 0 || (
+        conf.timer_deadline != 0 && conf.timer_deadline <= deadline
+    )) {
+        return;
+    }
+
+    spec.it_value.tv_sec  = deadline / 1000000;
+    spec.it_value.tv_nsec = deadline % 1000000 * 1000;
+
+    if(timerfd_settime(conf.timer_fd, TFD_TIMER_ABSTIME, &spec, NULL) < 0) {
+        perror(PROGRAM": timerfd_settime()");
+        return;
+    }
+    conf.timer_deadline = deadline;
+}
+
+static void daemon_timer_expired() {
+    unsigned long long now;
+    uint64_t expirations;
+
+    while(read(conf.timer_fd, &expirations, sizeof(expirations)) > 0);
+
+    conf.timer_deadline = 0;
+    now = daemon_monotonic_us();
+    idle_event_expire(now);
+    daemon_exec_pending();
+    daemon_timer_arm(idle_event_deadline());
+    daemon_timer_arm(sequence_event_expire(now));
+    daemon_timer_arm(gesture_event_expire(now));
+}
+
+static void daemon_signal() {
+    struct signalfd_siginfo info;
+
+    while(read(conf.signal_fd, &info, sizeof(info)) == sizeof(info)) {
+        switch(info.ssi_signo) {
+            case SIGHUP:
+                daemon_reload();
+                break;
+            case SIGUSR1:
+                daemon_stats_dump();
+                break;
+            case SIGCHLD:
+                daemon_exec_reap();
+                break;
+            case SIGTERM:
+            case SIGINT:
+                /* cleaned up by daemon_clean() on the way out of main() */
+                conf.quit = 1;
+                break;
+        }
+    }
+}
+
+static void daemon_reload() {
+    bindings_t *new, *old;
+    unsigned long long start;
+    int i, j;
+
+    start = daemon_monotonic_us();
+
+    if((new = config_load()) == NULL) {
+        fprintf(stderr, PROGRAM": reload failed, keeping old configuration\n");
+        return;
+    }
+
+    /* close devices which are no longer configured, matched ones are
+     * checked against the new rules once they are in use */
+    for(i=0; i < conf.listener_n; i++) {
+        listener_t *listener = conf.listener[i];
+
+        if(listener->path == NULL || listener->matched) {
             continue;
         }
+        for(j=0; j < new->listen_n; j++) {
+            if(strcmp(new->listen[j].path, listener->path) == 0) {
+                break;
+            }
+        }
+        /* a device which is (no longer) grabbed is opened again */
+        if(j == new->listen_n || new->listen[j].grab != listener->grab) {
+            input_remove_listener(listener);
+        }
+    }
 
-        key = value = line;
-        strsep(&value, "=");
-        if(value == NULL) {
-            error = "Invalid syntax!";
-            goto print_error;
+    /* running children and deferred commands refer to the old bindings */
+    for(i=0; i < conf.child_n; i++) {
+        conf.children[i].limit = NULL;
+    }
+    conf.pending_n = 0;
+
+    /* started sequences, gestures and axis latches refer to the old
+     * bindings */
+    for(i=0; i < conf.listener_n; i++) {
+        memset(conf.listener[i]->axes.latched, 0,
+            sizeof(conf.listener[i]->axes.latched));
+        conf.listener[i]->keys.sequence = 0;
+        conf.listener[i]->keys.gesture_phase = GESTURE_IDLE;
+        conf.listener[i]->keys.gesture_deadline = 0;
+    }
+    conf.key_state.sequence = 0;
+    conf.key_state.gesture_phase = GESTURE_IDLE;
+    conf.key_state.gesture_deadline = 0;
+
+    /* an option which is left out falls back to its default */
+    if(new->global_key_state != conf.global_key_state) {
+        memset(&conf.key_state, 0, sizeof(key_state_t));
+        for(i=0; i < conf.listener_n; i++) {
+            memset(&conf.listener[i]->keys, 0, sizeof(key_state_t));
         }
+        conf.global_key_state = new->global_key_state;
+    }
 
-        key = config_trim_string(key);
-        value = config_trim_string(value);
+    if(new->exec_mode != conf.exec_mode) {
+        if(new->exec_mode == EXEC_HELPER) {
+            daemon_exec_helper_start();
+        } else if(conf.helper_fd >= 0) {
+            /* the helper leaves on EOF and is reaped as any child */
+            close(conf.helper_fd);
+            conf.helper_fd = -1;
+        }
+        conf.exec_mode = new->exec_mode;
+    }
 
-        if(section == NULL) {
-            error = "Missing section!";
-        } else if(strlen(key) == 0 || strlen(value) == 0) {
-            error = "Invlaid syntax!";
-        } else if(strcasecmp(section, "Global") == 0) {
-            if(strcmp(key, "listen") == 0) {
-                if(listen_len < MAX_LISTENER) {
-                    conf.listen[listen_len++] = strdup(value);
-                } else {
-                    error = "Listener limit exceeded!";
+    old = bindings;
+    bindings = new;
+    config_free_bindings(old);
+
+    /* keep the idle time, but schedule against the new timeouts */
+    idle_event_schedule(daemon_monotonic_us());
+    daemon_timer_arm(idle_event_deadline());
+
+    /* a matched device stays open as long as a rule with the same grab
+     * matches it, so its clone, key and switch state are kept */
+    for(i=0; i < conf.listener_n; i++) {
+        listener_t *listener = conf.listener[i];
+        unsigned int scope;
+
+        if(listener->path == NULL || !listener->matched) {
+            continue;
+        }
+        for(j=0; j < bindings->listen_n; j++) {
+            if(strcmp(bindings->listen[j].path, listener->path) == 0) {
+                break;
+            }
+        }
+
+        /* listed now, it is opened again as such below */
+        scope = (listener->fd >= 0 && j == bindings->listen_n) ?
+            input_match_device(listener->fd) : 0;
+        if(scope == 0 || bindings->devices[scope-1].grab != listener->grab) {
+            input_remove_listener(listener);
+        }
+    }
+
+    /* open the newly configured ones, existing fds are kept */
+    for(i=0; i < bindings->listen_n; i++) {
+        listener_t *listener = input_add_listener(bindings->listen[i].path);
+
+        if(listener == NULL || listener->fd >= 0) {
+            continue;
+        }
+        listener->grab = bindings->listen[i].grab;
+        if(conf.inotify_fd >= 0) {
+            input_watch_directory(listener->path);
+        }
+        if(input_open_listener(listener) < 0) {
+            fprintf(stderr, PROGRAM": open(%s): %s\n",
+                listener->path, strerror(errno));
+        }
+    }
+
+    /* scopes are indices into the new device rules, the rest is
+     * matched again */
+    for(i=0; i < conf.listener_n; i++) {
+        if(conf.listener[i]->path != NULL && conf.listener[i]->fd >= 0) {
+            conf.listener[i]->scope = input_match_device(conf.listener[i]->fd);
+        }
+    }
+
+    input_match_all();
+    if(bindings->device_n > 0 && conf.inotify_fd >= 0) {
+        input_watch_directory("/dev/input/event0");
+    }
+
+    for(i=0; i < conf.listener_n; i++) {
+        listener_t *listener = conf.listener[i];
+
+        if(
+            listener->path != NULL && listener->matched && listener->fd < 0 &&
+            input_open_listener(listener) < 0
+        ) {
+            fprintf(stderr, PROGRAM": open(%s): %s\n",
+                listener->path, strerror(errno));
+        }
+    }
+
+    if(conf.verbose) {
+        fprintf(stderr, PROGRAM": reloaded %s in %llu us "
+            "(%zu keys, %zu idle, %zu switches)\n",
+            conf.configfile, daemon_monotonic_us() - start,
+            bindings->key_event_n, bindings->idle_event_n,
+            bindings->switch_event_n);
+    }
+}
+
+static unsigned long long daemon_monotonic_us() {
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+
+    return (unsigned long long) ts.tv_sec * 1000000 + ts.tv_nsec / 1000;
+}
+
+static void daemon_exec_init() {
+    sigset_t signals;
+
+    posix_spawnattr_init(&conf.spawn_attr);
+    posix_spawn_file_actions_init(&conf.spawn_actions);
+
+    /* children get default signal handling and their own process group,
+     * so a CTRL+C on our terminal does not reach them */
+    sigfillset(&signals);
+    posix_spawnattr_setsigdefault(&conf.spawn_attr, &signals);
+    sigemptyset(&signals);
+    posix_spawnattr_setsigmask(&conf.spawn_attr, &signals);
+    posix_spawnattr_setpgroup(&conf.spawn_attr, 0);
+    posix_spawnattr_setflags(&conf.spawn_attr,
+        POSIX_SPAWN_SETSIGDEF | POSIX_SPAWN_SETSIGMASK |
+        POSIX_SPAWN_SETPGROUP | POSIX_SPAWN_USEVFORK);
+
+    if(!conf.verbose) {
+        posix_spawn_file_actions_addopen(&conf.spawn_actions,
+            STDIN_FILENO, "/dev/null", O_RDONLY, 0);
+        posix_spawn_file_actions_addopen(&conf.spawn_actions,
+            STDOUT_FILENO, "/dev/null", O_WRONLY, 0);
+        posix_spawn_file_actions_addopen(&conf.spawn_actions,
+            STDERR_FILENO, "/dev/null", O_WRONLY, 0);
+    }
+
+    if(conf.exec_mode == EXEC_HELPER) {
+        daemon_exec_helper_start();
+    }
+}
+
+static pid_t daemon_exec_spawn(const char *line, char *const *argv) {
+    pid_t pid;
+    int error;
+
+    if(argv != NULL) {
+        error = posix_spawnp(&pid, argv[0], &conf.spawn_actions,
+            &conf.spawn_attr, argv, environ);
+    } else {
+        const char *args[] = {
+            "sh", "-c", line, NULL
+        };
+
+        error = posix_spawn(&pid, "/bin/sh", &conf.spawn_actions,
+            &conf.spawn_attr, (char *const *) args, environ);
+    }
+
+    if(error != 0) {
+        fprintf(stderr, PROGRAM": posix_spawn(%s): %s\n",
+            line, strerror(error));
+        return -1;
+    }
+
+    return pid;
+}
+
+static void daemon_exec_helper(int fd) {
+    char buffer[PIPE_BUF+1], *argv[PIPE_BUF/2+1], *ptr;
+    sigset_t signals;
+    unsigned short len;
+    size_t n, argc;
+    ssize_t r;
+
+    /* the helper only spawns commands, it does not handle our events */
+    signal(SIGINT,  SIG_DFL);
+    signal(SIGTERM, SIG_DFL);
+    signal(SIGHUP,  SIG_IGN);
+    signal(SIGCHLD, SIG_IGN);
+    sigemptyset(&signals);
+    sigprocmask(SIG_SETMASK, &signals, NULL);
+
+    while(1) {
+        /* message: length, argc (0 means shell), NUL separated strings */
+        for(n=0; n < sizeof(len); n += r) {
+            if((r = read(fd, (char *) &len + n, sizeof(len) - n)) <= 0) {
+                if(r < 0 && errno == EINTR) {
+                    r = 0;
+                    continue;
                 }
-            } else {
-                error = "Unkown option!";
+                _exit(EXIT_SUCCESS);
             }
-        } else if(strcasecmp(section, "Keys") == 0) {
-            error = config_key_event(key, value);
-        } else if(strcasecmp(section, "Idle") == 0) {
-            error = config_idle_event(key, value);
-        } else if(strcasecmp(section, "Switches") == 0) {
-            error = config_switch_event(key, value);
-        } else {
-            error = "Unknown section!";
-            section = NULL;
         }
 
-        print_error:
-        if(error != NULL) {
-            fprintf(stderr, PROGRAM": %s (%s:%d)\n",
-                error, conf.configfile, line_num);
+        for(n=0; n < len; n += r) {
+            if((r = read(fd, buffer + n, len - n)) <= 0) {
+                if(r < 0 && errno == EINTR) {
+                    r = 0;
+                    continue;
+                }
+                _exit(EXIT_SUCCESS);
+            }
         }
+        buffer[len] = '\0';
 
+        argc = (unsigned char) buffer[0];
+        ptr = buffer + 1;
+        for(n=0; n < argc && ptr < buffer + len; n++) {
+            argv[n] = ptr;
+            ptr += strlen(ptr) + 1;
+        }
+        argv[n] = NULL;
 
+        daemon_exec_spawn(buffer + 1, argc > 0 ? argv : NULL);
     }
+}
 
-    qsort(key_events, key_event_n, sizeof(key_event_t),
-        (int (*)(const void *, const void *)) key_event_compare);
+static void daemon_exec_helper_close(int keep) {
+    struct dirent *entry;
+    DIR *dir;
+    long fd, max;
+
+    /* the helper never execs, O_CLOEXEC does not apply: without this it
+     * would hold on to devices, grabs and uinput clones of the daemon */
+    if((dir = opendir("/proc/self/fd")) != NULL) {
+        while((entry = readdir(dir)) != NULL) {
+            fd = strtol(entry->d_name, NULL, 10);
+            if(
+                entry->d_name[0] != '.' && fd > STDERR_FILENO &&
+                fd != keep && fd != dirfd(dir)
+            ) {
+                close(fd);
+            }
+        }
+        closedir(dir);
+        return;
+    }
 
-    qsort(idle_events, idle_event_n, sizeof(idle_event_t),
-        (int (*)(const void *, const void *)) idle_event_compare);
+    max = sysconf(_SC_OPEN_MAX);
+    for(fd = STDERR_FILENO + 1; fd < max; fd++) {
+        if(fd != keep) {
+            close(fd);
+        }
+    }
+}
 
-    qsort(switch_events, switch_event_n, sizeof(switch_event_t),
-        (int (*)(const void *, const void *)) switch_event_compare);
+static int daemon_exec_helper_start() {
+    int fds[2];
+    pid_t pid;
 
-    if(section != NULL) {
-        free(section);
+    if(pipe2(fds, O_CLOEXEC) < 0) {
+        perror(PROGRAM": pipe2()");
+        return -1;
     }
 
-    fclose(config_fd);
-}
+    pid = fork();
+    if(pid == 0) {
+        daemon_exec_helper_close(fds[0]);
+        daemon_exec_helper(fds[0]);
+        _exit(EXIT_SUCCESS);
+    } else if(pid < 0) {
+        perror(PROGRAM": fork()");
+        close(fds[0]);
+        close(fds[1]);
+        return -1;
+    }
 
-static const char *config_key_event(char *shortcut, char *exec) {
-    int i;
-    char *code, *modifier;
-    key_event_t *new_key_event;
+    close(fds[0]);
+    fcntl(fds[1], F_SETFL, O_NONBLOCK);
 
-    if(key_event_n >= MAX_EVENTS) {
-        return "Key event limit exceeded!";
-    } else {
-        new_key_event = &key_events[key_event_n++];
-    }
+    conf.helper_fd  = fds[1];
+    conf.helper_pid = pid;
 
-    new_key_event->modifier_n = 0;
-    for(i=0; i < MAX_MODIFIERS; i++) {
-        new_key_event->modifiers[i] = NULL;
+    if(conf.verbose) {
+        fprintf(stderr, PROGRAM": exec helper started (pid %d)\n", pid);
     }
 
-    if((code = strrchr(shortcut, '+')) != NULL) {
-        *code = '\0';
-        code = config_trim_string(code+1);
+    return 0;
+}
 
-        new_key_event->code = strdup(code);
+static int daemon_exec_helper_send(const command_t *command) {
+    char buffer[PIPE_BUF];
+    unsigned short len = 1;
+    size_t argc = 0, n;
 
-        modifier = strtok(shortcut, "+");
-        while(modifier != NULL && new_key_event->modifier_n < MAX_MODIFIERS) {
-            modifier = config_trim_string(modifier);
-            new_key_event->modifiers[new_key_event->modifier_n++] =
-                strdup(modifier);
+    if(conf.helper_fd < 0 && daemon_exec_helper_start() < 0) {
+        return -1;
+    }
 
-            modifier = strtok(NULL, "+");
+    if(command->argv != NULL) {
+        for(argc=0; command->argv[argc] != NULL; argc++) {
+            n = strlen(command->argv[argc]) + 1;
+            if(argc > 255 || sizeof(len) + len + n > sizeof(buffer)) {
+                return -1;
+            }
+            memcpy(buffer + sizeof(len) + len, command->argv[argc], n);
+            len += n;
         }
     } else {
-        new_key_event->code = strdup(shortcut);
+        n = strlen(command->line) + 1;
+        if(sizeof(len) + len + n > sizeof(buffer)) {
+            return -1;
+        }
+        memcpy(buffer + sizeof(len) + len, command->line, n);
+        len += n;
     }
 
-    new_key_event->exec = strdup(exec);
+    buffer[sizeof(len)] = argc;
+    memcpy(buffer, &len, sizeof(len));
 
-    qsort(new_key_event->modifiers, new_key_event->modifier_n,
-        sizeof(const char*), (int (*)(const void *, const void *)) strcmp);
+    /* a single write below PIPE_BUF is atomic, never block on the helper */
+    if(write(conf.helper_fd, buffer, sizeof(len) + len) < 0) {
+        if(errno != EAGAIN) {
+            fprintf(stderr, PROGRAM": exec helper: %s\n", strerror(errno));
+            close(conf.helper_fd);
+            conf.helper_fd = -1;
+        }
+        return -1;
+    }
 
-    return NULL;
+    return 0;
 }
 
-static const char *config_idle_event(char *timeout, char *exec) {
-    idle_event_t *new_idle_event;
-    unsigned long count;
-    char *unit;
+static void daemon_exec(const command_t *command) {
+    unsigned long long start, elapsed;
+    exec_stat_t *stat;
+    limit_t *limit = command->limit;
+    int mode, failed = 0;
+    pid_t pid;
 
-    if(idle_event_n >= MAX_EVENTS) {
-        return "Idle event limit exceeded!";
-    } else {
-        new_idle_event = &idle_events[idle_event_n++];
+    /* replaying a trace only measures the dispatch path */
+    if(conf.replay) {
+        return;
     }
 
-    new_idle_event->timeout = 0;
-    new_idle_event->exec = strdup(exec);
+    start = daemon_monotonic_us();
 
-    if(strcasecmp(timeout, "RESET") == 0) {
-        new_idle_event->timeout = IDLE_RESET;
-        return NULL;
+    if(limit != NULL && !daemon_exec_allowed(command, start)) {
+        return;
     }
 
-    while(*timeout) {
-        while(*timeout && !isdigit(*timeout)) timeout++;
-        count = strtoul(timeout, &unit, 10);
+    if(conf.event_us > 0 && start >= conf.event_us) {
+        daemon_stats_add(&conf.dispatch, start - conf.event_us);
+    }
 
-        switch(*unit) {
-        case 'h':
-            new_idle_event->timeout += count * 3600;
-            break;
-        case 'm':
-            new_idle_event->timeout += count * 60;
-            break;
-        case 's':
-        default:
-            new_idle_event->timeout += count;
-            break;
+    if(command->builtin != NULL) {
+        mode = EXEC_BUILTIN;
+        failed = daemon_builtin(command->builtin) < 0;
+    } else if(
+        /* the helper's children can not be counted */
+        conf.exec_mode == EXEC_HELPER && (limit == NULL || limit->max == 0) &&
+        daemon_exec_helper_send(command) == 0
+    ) {
+        mode = EXEC_HELPER;
+    } else {
+        /* fall back to spawning ourselves if the helper is unavailable */
+        if(command->argv != NULL && conf.exec_mode != EXEC_SHELL) {
+            mode = EXEC_DIRECT;
+        } else {
+            mode = EXEC_SHELL;
         }
 
-        timeout = unit;
-    }
+        pid = daemon_exec_spawn(
+            command->line, (mode == EXEC_DIRECT) ? command->argv : NULL
+        );
 
-    conf.min_timeout = config_min_timeout(
-        new_idle_event->timeout, conf.min_timeout);
+        if(pid < 0) {
+            failed = 1;
+        } else if(limit != NULL && limit->max > 0) {
+            daemon_exec_track(pid, limit);
+        }
+    }
 
-    return NULL;
-}
+    elapsed = daemon_monotonic_us() - start;
 
-static const char *config_switch_event(char *switchcode, char *exec) {
-    char *code, *value;
-    switch_event_t *new_switch_event;
+    stat = &conf.exec_stats[mode];
+    stat->failed += failed;
+    daemon_stats_add(&stat->latency, elapsed);
 
-    if(switch_event_n >= MAX_EVENTS) {
-        return "Switch event limit exceeded!";
-    } else {
-        new_switch_event = &switch_events[switch_event_n++];
+    if(conf.verbose) {
+        fprintf(stderr, PROGRAM": exec (%s) took %llu us\n",
+            EXEC_MODE_NAME[mode], elapsed);
     }
+}
 
-    code = value = switchcode;
-    strsep(&value, ":");
-    if(value == NULL) {
-        switch_event_n--;
-        return "Invalid switch identifier";
+static int daemon_builtin(const builtin_t *builtin) {
+    int fd, i;
+    ssize_t written = 0;
+    listener_t *listener;
+
+    switch(builtin->type) {
+        case BUILTIN_WRITE:
+            /* sysfs attributes want a single write of the whole value */
+            if((fd = open(builtin->path,
+                O_WRONLY | O_TRUNC | O_NONBLOCK | O_CLOEXEC)) < 0
+            ) {
+                break;
+            }
+            written = write(fd, builtin->data, builtin->length);
+            close(fd);
+            return (written == builtin->length) ? 0 : daemon_builtin_error(
+                "write", builtin->path, written < 0 ? errno : EIO);
+        case BUILTIN_SEND:
+            return daemon_builtin_send(builtin);
+        case BUILTIN_EMIT:
+            return daemon_builtin_emit(builtin);
+        case BUILTIN_LED:
+            if(conf.source != NULL) {
+                return daemon_builtin_led(builtin, conf.source);
+            }
+            /* without an event, e.g. on idle, all devices are set */
+            for(i=0; i < conf.listener_n; i++) {
+                listener = conf.listener[i];
+                if(listener->fd >= 0) {
+                    daemon_builtin_led(builtin, listener);
+                }
+            }
+            return 0;
     }
 
-    code = config_trim_string(code);
-    value = config_trim_string(value);
-
-    new_switch_event->code = strdup(code);
-    new_switch_event->value = atoi(value);
-    new_switch_event->exec = strdup(exec);
+    return daemon_builtin_error("open", builtin->path, errno);
+}
 
-    return NULL;
+static int daemon_builtin_error(const char *what, const char *path, int error) {
+    fprintf(stderr, PROGRAM": %s(%s): %s\n", what, path, strerror(error));
+    return -1;
 }
 
-static unsigned int config_min_timeout(unsigned long a, unsigned long b) {
-    if(b == 0) return a;
+static int daemon_builtin_send(const builtin_t *builtin) {
+    struct sockaddr_un addr = { .sun_family = AF_UNIX };
+    struct stat st;
+    int fd, error = 0;
 
-    return config_min_timeout(b, a % b);
-}
+    if(stat(builtin->path, &st) < 0) {
+        return daemon_builtin_error("stat", builtin->path, errno);
+    }
 
-static char *config_trim_string(char *str) {
-    char *end;
+    if(!S_ISSOCK(st.st_mode)) {
+        /* a FIFO without reader fails with ENXIO instead of blocking */
+        if((fd = open(builtin->path, O_WRONLY | O_NONBLOCK | O_CLOEXEC)) < 0) {
+            return daemon_builtin_error("open", builtin->path, errno);
+        }
+        if(write(fd, builtin->data, builtin->length) < 0) {
+            error = errno;
+        }
+        close(fd);
+        return error ? daemon_builtin_error("write", builtin->path, error) : 0;
+    }
 
-    while(isspace(*str)) str++;
+    strncpy(addr.sun_path, builtin->path, sizeof(addr.sun_path) - 1);
 
-    end = str + strlen(str) - 1;
-    while(end > str && isspace(*end)) end--;
+    /* datagram sockets first, then a short-lived stream connection */
+    fd = socket(AF_UNIX, SOCK_DGRAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+    if(fd >= 0 && sendto(fd, builtin->data, builtin->length, MSG_NOSIGNAL,
+        (struct sockaddr *) &addr, sizeof(addr)) >= 0
+    ) {
+        close(fd);
+        return 0;
+    } else if(fd >= 0) {
+        close(fd);
+    }
 
-    *(end+1) = '\0';
+    fd = socket(AF_UNIX, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+    if(
+        fd < 0 ||
+        connect(fd, (struct sockaddr *) &addr, sizeof(addr)) < 0 ||
+        send(fd, builtin->data, builtin->length, MSG_NOSIGNAL) < 0
+    ) {
+        error = errno;
+    }
+    if(fd >= 0) {
+        close(fd);
+    }
 
-    return str;
+    return error ? daemon_builtin_error("send", builtin->path, error) : 0;
 }
 
-void daemon_init() {
-    int i;
+static int daemon_builtin_emit(const builtin_t *builtin) {
+    struct uinput_user_dev dev;
+    struct input_event events[4];
+    size_t n = 0;
+    int code;
 
-    conf.configfile  = "/etc/input-event-daemon.conf";
+    /* the virtual keyboard is created on first use */
+    if(conf.uinput_fd < 0) {
+        if((conf.uinput_fd = open("/dev/uinput",
+            O_WRONLY | O_NONBLOCK | O_CLOEXEC)) < 0
+        ) {
+            return daemon_builtin_error("open", "/dev/uinput", errno);
+        }
 
-    conf.monitor     = 0;
-    conf.verbose     = 0;
-    conf.daemon      = 1;
+        ioctl(conf.uinput_fd, UI_SET_EVBIT, EV_KEY);
+        ioctl(conf.uinput_fd, UI_SET_EVBIT, EV_SYN);
+        for(code=1; code < KEY_CNT; code++) {
+            if(KEY_NAME[code] != NULL) {
+                ioctl(conf.uinput_fd, UI_SET_KEYBIT, code);
+            }
+        }
 
-    conf.min_timeout = 3600;
+        memset(&dev, 0, sizeof(dev));
+        snprintf(dev.name, UINPUT_MAX_NAME_SIZE, PROGRAM);
+        dev.id.bustype = BUS_VIRTUAL;
+        ioctl(conf.uinput_fd, UI_SET_PHYS, UINPUT_PHYS);
 
-    for(i=0; i<MAX_LISTENER; i++) {
-        conf.listen[i]    = NULL;
-        conf.listen_fd[i] = 0;
+        if(
+            write(conf.uinput_fd, &dev, sizeof(dev)) != sizeof(dev) ||
+            ioctl(conf.uinput_fd, UI_DEV_CREATE) < 0
+        ) {
+            daemon_builtin_error("create", "/dev/uinput", errno);
+            close(conf.uinput_fd);
+            conf.uinput_fd = -1;
+            return -1;
+        }
     }
-}
 
-void daemon_start_listener() {
-    int i, n, select_r, fd_len;
-    unsigned long tms_start, tms_end, idle_time = 0;
-    unsigned char sw_states[SW_MAX/8 + 1];
-    fd_set fdset, initial_fdset;
-    struct input_event event;
-    struct timeval tv, tv_start, tv_end;
-    struct termios monitoring_terminal;
+    memset(events, 0, sizeof(events));
+    if(builtin->value < 0) {
+        events[n].type = EV_KEY; events[n].code = builtin->code;
+        events[n++].value = 1;
+        events[n].type = EV_SYN; events[n++].code = SYN_REPORT;
+        events[n].type = EV_KEY; events[n].code = builtin->code;
+        events[n++].value = 0;
+    } else {
+        events[n].type = EV_KEY; events[n].code = builtin->code;
+        events[n++].value = builtin->value;
+    }
+    events[n].type = EV_SYN; events[n++].code = SYN_REPORT;
 
-    /* ignored forked processes */
-    signal(SIGCHLD, SIG_IGN);
+    if(write(conf.uinput_fd, events, n * sizeof(events[0])) < 0) {
+        return daemon_builtin_error("write", "/dev/uinput", errno);
+    }
 
-    FD_ZERO(&initial_fdset);
-    for(i=0; i < MAX_LISTENER && conf.listen[i] != NULL; i++) {
-        conf.listen_fd[i] = open(conf.listen[i], O_RDONLY);
+    return 0;
+}
 
-        if(conf.listen_fd[i] < 0) {
-            fprintf(stderr, PROGRAM": open(%s): %s\n",
-                conf.listen[i], strerror(errno));
-            exit(EXIT_FAILURE);
-        }
-        FD_SET(conf.listen_fd[i], &initial_fdset);
-        ioctl(conf.listen_fd[i], EVIOCGSW(sizeof(sw_states)), &sw_states);
-        for (n=0; n < SW_MAX; n++) {
-            memset(&event, '\0', sizeof(event));
-            event.type = EV_SW;
-            event.code = n;
-            event.value = (sw_states[n/8] >> n%8) & 0x1;
-            input_parse_event(&event, conf.listen[i]);
-        }
+static int daemon_builtin_led(const builtin_t *builtin, listener_t *listener) {
+    unsigned char leds[LED_MAX/8 + 1];
+    struct input_event events[2];
+
+    memset(events, 0, sizeof(events));
+    events[0].type  = EV_LED;
+    events[0].code  = builtin->code;
+    events[0].value = builtin->value;
+    events[1].type  = EV_SYN;
+    events[1].code  = SYN_REPORT;
+
+    if(builtin->value < 0) {
+        memset(leds, 0, sizeof(leds));
+        ioctl(listener->fd, EVIOCGLED(sizeof(leds)), leds);
+        events[0].value = !test_bit(leds, builtin->code);
     }
 
-    fd_len = i;
-
-    if(fd_len == 0) {
-        fprintf(stderr, PROGRAM": no listener found!\n");
-        return;
+    /* LEDs are set by writing events to the device */
+    if(write(listener->fd, events, sizeof(events)) < 0) {
+        return daemon_builtin_error("write", listener->path, errno);
     }
 
-    if(conf.verbose) {
-        fprintf(stderr, PROGRAM": Start listening on %d devices...\n", fd_len);
+    return 0;
+}
+
+static int daemon_exec_blocked(const limit_t *limit, unsigned long long now) {
+    if(
+        limit->debounce_us > 0 && limit->last_us > 0 &&
+        now < limit->last_us + limit->debounce_us
+    ) {
+        return EXEC_DEBOUNCED;
+    } else if(limit->max > 0 && limit->running >= limit->max) {
+        return EXEC_BUSY;
     }
 
-    if(conf.monitor) {
-        printf(PROGRAM": Monitoring mode started. Press CTRL+C to abort.\n\n");
+    return 0;
+}
 
-        /* get current terminal settings */
-        if(tcgetattr(STDIN_FILENO, &conf.terminal) < 0) {
-            perror(PROGRAM": tcgetattr()");
-            exit(EXIT_FAILURE);
-        }
+static int daemon_exec_allowed(const command_t *command, unsigned long long now) {
+    limit_t *limit = command->limit;
+    int blocked = daemon_exec_blocked(limit, now);
 
-        /* disable echo on terminal */
-        monitoring_terminal = conf.terminal;
-        monitoring_terminal.c_lflag &= ~ECHO;
+    if(!blocked) {
+        limit->last_us = now;
+        return 1;
+    }
 
-        if(tcsetattr(STDIN_FILENO, TCSAFLUSH, &monitoring_terminal) < 0) {;
-            perror(PROGRAM": tcsetattr()");
-        }
+    /* coalesced commands run once more when they are allowed again */
+    if(limit->coalesce && !limit->pending) {
+        limit->pending = 1;
+        conf.pending = config_grow(conf.pending, conf.pending_n,
+            &conf.pending_max, sizeof(const command_t *));
+        conf.pending[conf.pending_n++] = command;
+        conf.exec_deferred++;
 
-    } else if(conf.daemon) {
-        if(daemon(1, conf.verbose) < 0) {
-            perror(PROGRAM": daemon()");
-            exit(EXIT_FAILURE);
+        if(blocked == EXEC_DEBOUNCED) {
+            daemon_timer_arm(limit->last_us + limit->debounce_us);
         }
+    } else {
+        conf.exec_dropped++;
     }
 
-    while(1) {
-        fdset = initial_fdset;
-        tv.tv_sec = conf.min_timeout;
-        tv.tv_usec = 0;
+    if(conf.verbose) {
+        fprintf(stderr, PROGRAM": exec %s (%s): \"%s\"\n",
+            limit->pending ? "deferred" : "dropped",
+            blocked == EXEC_DEBOUNCED ? "debounce" : "busy", command->line);
+    }
 
-        gettimeofday(&tv_start, NULL);
+    return 0;
+}
 
-        select_r = select(conf.listen_fd[fd_len-1]+1, &fdset, NULL, NULL, &tv);
+static void daemon_exec_pending() {
+    const command_t *command;
+    unsigned long long now = daemon_monotonic_us();
+    size_t i, n;
+    int blocked;
 
-        gettimeofday(&tv_end, NULL);
+    for(i=0, n=0; i < conf.pending_n; i++) {
+        command = conf.pending[i];
+        blocked = daemon_exec_blocked(command->limit, now);
 
-        if(select_r < 0) {
-            perror(PROGRAM": select()");
-            break;
-        } else if(select_r == 0) {
-            idle_time += conf.min_timeout;
-            idle_event_parse(idle_time);
+        if(blocked) {
+            if(blocked == EXEC_DEBOUNCED) {
+                daemon_timer_arm(
+                    command->limit->last_us + command->limit->debounce_us);
+            }
+            conf.pending[n++] = command;
             continue;
         }
 
-        tms_start = tv_start.tv_sec * 1000 + tv_start.tv_usec / 1000;
-        tms_end   = tv_end.tv_sec  *  1000 + tv_end.tv_usec  /  1000;
+        command->limit->pending = 0;
+        daemon_exec(command);
+    }
+    conf.pending_n = n;
+}
+
+static void daemon_exec_track(pid_t pid, limit_t *limit) {
+    conf.children = config_grow(conf.children, conf.child_n,
+        &conf.child_max, sizeof(child_t));
+    conf.children[conf.child_n].pid = pid;
+    conf.children[conf.child_n].limit = limit;
+    conf.child_n++;
+
+    limit->running++;
+}
+
+static void daemon_exec_reap() {
+    pid_t pid;
+    size_t i;
 
-        if(tms_end - tms_start > 750 || idle_time > 0) {
-            idle_event_parse(IDLE_RESET);
-            idle_time = 0;
+    while((pid = waitpid(-1, NULL, WNOHANG)) > 0) {
+        if(pid == conf.helper_pid) {
+            /* restarted by the next daemon_exec_helper_send() */
+            if(conf.helper_fd >= 0) {
+                close(conf.helper_fd);
+                conf.helper_fd = -1;
+            }
+            conf.helper_pid = 0;
+            continue;
         }
 
-        for(i=0; i<fd_len; i++) {
-            if(FD_ISSET(conf.listen_fd[i], &fdset)) {
-                if(read(conf.listen_fd[i], &event, sizeof(event)) < 0) {
-                    fprintf(stderr, PROGRAM": read(%s): %s\n",
-                        conf.listen[i], strerror(errno));
-                    break;
+        for(i=0; i < conf.child_n; i++) {
+            if(conf.children[i].pid == pid) {
+                if(conf.children[i].limit != NULL) {
+                    conf.children[i].limit->running--;
                 }
-                input_parse_event(&event, conf.listen[i]);
+                conf.children[i] = conf.children[--conf.child_n];
+                break;
             }
         }
     }
+
+    if(conf.pending_n > 0) {
+        daemon_exec_pending();
+    }
 }
 
-static void daemon_exec(const char *command) {
-    pid_t pid = fork();
-    if(pid == 0) {
-        const char *args[] = {
-            "sh", "-c", command, NULL
-        };
+static void daemon_stats_add(latency_t *latency, unsigned long long us) {
+    int i;
 
+    /* bucket i counts latencies below 2^i us */
+    for(i=0; i < LATENCY_BUCKETS-1 && (us >> i) != 0; i++);
 
-        if(!conf.verbose) {
-            int null_fd = open("/dev/null", O_RDWR, 0);
-            if(null_fd > 0) {
-                dup2(null_fd, STDIN_FILENO);
-                dup2(null_fd, STDOUT_FILENO);
-                dup2(null_fd, STDERR_FILENO);
-                if(null_fd > STDERR_FILENO) {
-                    close(null_fd);
-                }
-            }
+    latency->bucket[i]++;
+    latency->count++;
+    latency->total_us += us;
+    if(us > latency->max_us) {
+        latency->max_us = us;
+    }
+}
+
+static void
+daemon_stats_print_latency(FILE *stream, const char *name,
+    const latency_t *latency) {
+    int i;
+
+    fprintf(stream, "latency %s count %lu sum_us %llu max_us %llu buckets",
+        name, latency->count, latency->total_us, latency->max_us);
+    for(i=0; i < LATENCY_BUCKETS; i++) {
+        fprintf(stream, " %lu", latency->bucket[i]);
+    }
+    fprintf(stream, "\n");
+}
+
+static void daemon_stats_dump() {
+    FILE *stream = stderr;
+    char tmpfile[PATH_MAX];
+    char name[32];
+    int i;
+
+    /* write a temporary file and rename it, readers never see a partial dump */
+    if(bindings->stats_file != NULL) {
+        snprintf(tmpfile, sizeof(tmpfile), "%s.tmp", bindings->stats_file);
+        if((stream = fopen(tmpfile, "w")) == NULL) {
+            fprintf(stderr, PROGRAM": fopen(%s): %s\n",
+                tmpfile, strerror(errno));
+            return;
+        }
+    }
+
+    fprintf(stream, "uptime_us %llu\n", daemon_monotonic_us() - conf.start_us);
+    fprintf(stream, "events %lu\n", conf.event_count);
+    fprintf(stream, "reads %lu\n", conf.read_count);
+    fprintf(stream, "keys_matched %lu\n", conf.key_matched);
+    fprintf(stream, "sequences_matched %lu\n", conf.sequence_matched);
+    fprintf(stream, "switches_matched %lu\n", conf.switch_matched);
+    fprintf(stream, "axes_matched %lu\n", conf.axis_matched);
+    fprintf(stream, "resyncs %lu\n", conf.resync_count);
+    fprintf(stream, "idle_fired %lu\n", conf.idle_fired);
+    fprintf(stream, "exec_dropped %lu\n", conf.exec_dropped);
+    fprintf(stream, "exec_deferred %lu\n", conf.exec_deferred);
+
+    for(i=0; i < conf.listener_n; i++) {
+        listener_t *listener = conf.listener[i];
+
+        if(listener->path == NULL) {
+            continue;
         }
+        fprintf(stream, "device %s open %d events %lu reads %lu\n",
+            listener->path, listener->fd >= 0,
+            listener->event_count, listener->read_count);
+    }
 
-        signal(SIGINT,  SIG_IGN);
-        signal(SIGQUIT, SIG_IGN);
+    daemon_stats_print_latency(stream, "dispatch", &conf.dispatch);
+    daemon_stats_print_latency(stream, "passthrough", &conf.passthrough);
 
-        execv("/bin/sh", (char *const *) args);
-        _exit(127);
-    } else if(pid < 0) {
-        perror(PROGRAM": fork()");
+    for(i=0; i < EXEC_MODES; i++) {
+        fprintf(stream, "exec %s commands %lu failed %lu\n",
+            EXEC_MODE_NAME[i], conf.exec_stats[i].latency.count,
+            conf.exec_stats[i].failed);
+
+        snprintf(name, sizeof(name), "exec_%s", EXEC_MODE_NAME[i]);
+        daemon_stats_print_latency(stream, name, &conf.exec_stats[i].latency);
     }
 
-    return;
+    if(stream != stderr) {
+        if(fclose(stream) != 0 || rename(tmpfile, bindings->stats_file) < 0) {
+            fprintf(stderr, PROGRAM": %s: %s\n",
+                bindings->stats_file, strerror(errno));
+            unlink(tmpfile);
+        }
+    }
 }
 
 void daemon_clean() {
-    int i, j;
+    int i;
 
     if(conf.verbose) {
         fprintf(stderr, "\n"PROGRAM": Exiting...\n");
+        if(conf.read_count > 0) {
+            fprintf(stderr, PROGRAM": %lu events in %lu reads "
+                "(%.1f events/read)\n", conf.event_count, conf.read_count,
+                (double) conf.event_count / conf.read_count);
+        }
+        for(i=0; i < EXEC_MODES; i++) {
+            exec_stat_t *stat = &conf.exec_stats[i];
+            if(stat->latency.count > 0) {
+                fprintf(stderr, PROGRAM": exec (%s): %lu commands, "
+                    "%lu failed, avg %llu us, max %llu us\n",
+                    EXEC_MODE_NAME[i], stat->latency.count, stat->failed,
+                    stat->latency.total_us / stat->latency.count,
+                    stat->latency.max_us);
+            }
+        }
+    }
+
+    if(conf.capture != NULL) {
+        fclose(conf.capture);
+        conf.capture = NULL;
+    }
+
+    free(conf.children);
+    free(conf.pending);
+    conf.children = NULL;
+    conf.pending = NULL;
+    conf.child_n = conf.pending_n = 0;
+
+    if(bindings != NULL) {
+        config_free_bindings(bindings);
+        bindings = NULL;
     }
 
-    for(i=0; i<key_event_n; i++) {
-        free((void*) key_events[i].code);
-        for(j=0; j<key_events[i].modifier_n; j++) {
-            free((void*) key_events[i].modifiers[j]);
+    for(i=0; i < conf.listener_n; i++) {
+        if(conf.listener[i]->path != NULL) {
+            input_remove_listener(conf.listener[i]);
         }
-        free((void*) key_events[i].exec);
+        free(conf.listener[i]);
     }
-    key_event_n = 0;
+    free(conf.listener);
+    conf.listener = NULL;
+    conf.listener_n = 0;
 
-    for(i=0; i<idle_event_n; i++) {
-        free((void*) idle_events[i].exec);
+    for(i=0; i < conf.watch_n; i++) {
+        free((void*) conf.watch[i].dir);
     }
-    idle_event_n = 0;
+    free(conf.watch);
+    conf.watch = NULL;
+    conf.watch_n = 0;
 
-    for(i=0; i<switch_event_n; i++) {
-        free((void*) switch_events[i].code);
-        free((void*) switch_events[i].exec);
+    if(conf.inotify_fd >= 0) {
+        close(conf.inotify_fd);
     }
-    switch_event_n = 0;
 
-    for(i=0; i < MAX_LISTENER && conf.listen[i] != NULL; i++) {
-        free((void*) conf.listen[i]);
-        conf.listen[i] = NULL;
-        if(conf.listen_fd[i]) {
-            close(conf.listen_fd[i]);
-        }
+    if(conf.signal_fd >= 0) {
+        close(conf.signal_fd);
+    }
+
+    if(conf.timer_fd >= 0) {
+        close(conf.timer_fd);
+    }
+
+    if(conf.epoll_fd >= 0) {
+        close(conf.epoll_fd);
+    }
+
+    if(conf.helper_fd >= 0) {
+        close(conf.helper_fd);
+    }
+
+    if(conf.uinput_fd >= 0) {
+        ioctl(conf.uinput_fd, UI_DEV_DESTROY);
+        close(conf.uinput_fd);
+    }
+
+    if(conf.monitor_fd >= 0) {
+        monitor_clean();
     }
 
     if(conf.monitor) {
@@ -815,23 +5135,31 @@ void daemon_clean() {
         }
     }
 
+    /* _exit() skips the stdio buffers, e.g. of --help into a pipe */
+    fflush(stdout);
     _exit(EXIT_SUCCESS);
 }
 
 static void daemon_print_help() {
     printf("Usage:\n\n"
             "    "PROGRAM" "
-            "[ [ --monitor | --list | --help | --version ] |\n"
+            "[ [ --monitor[=events] | --list | --help | --version ] |\n"
+            "                         "
+            "[--config=FILE] [--cache=FILE] [--verbose] [--no-daemon]\n"
             "                         "
-            "[--config=FILE] [--verbose] [--no-daemon] ]\n"
+            "[--capture=FILE | --replay=FILE] ]\n"
             "\n"
             "Available Options:\n"
             "\n"
             "    -m, --monitor       Start in monitoring mode\n"
+            "                        (--monitor=events: one line per event)\n"
             "    -l, --list          List all input devices and quit\n"
             "    -c, --config FILE   Use specified config file\n"
+            "    -k, --cache FILE    Keep the parsed config file in FILE\n"
             "    -v, --verbose       Verbose output\n"
             "    -D, --no-daemon     Don't run in background\n"
+            "    -C, --capture FILE  Record all input events to FILE\n"
+            "    -R, --replay FILE   Benchmark the bindings with a recorded FILE\n"
             "\n"
             "    -h, --help          Show this help and quit\n"
             "    -V, --version       Show version number and quit\n"
@@ -847,12 +5175,16 @@ static void daemon_print_version() {
 
 int main(int argc, char *argv[]) {
     int result, arguments = 0;
+    const char *capture = NULL, *replay = NULL;
     static const struct option long_options[] = {
-        { "monitor",   no_argument,       0, 'm' },
+        { "monitor",   optional_argument, 0, 'm' },
         { "list",      no_argument,       0, 'l' },
         { "config",    required_argument, 0, 'c' },
+        { "cache",     required_argument, 0, 'k' },
         { "verbose",   no_argument,       0, 'v' },
         { "no-daemon", no_argument,       0, 'D' },
+        { "capture",   required_argument, 0, 'C' },
+        { "replay",    required_argument, 0, 'R' },
         { "help",      no_argument,       0, 'h' },
         { "version",   no_argument,       0, 'V' },
         {NULL,         0,              NULL,  0  }
@@ -861,11 +5193,9 @@ int main(int argc, char *argv[]) {
     daemon_init();
 
     atexit(daemon_clean);
-    signal(SIGTERM, daemon_clean);
-    signal(SIGINT,  daemon_clean);
 
     while (optind < argc) {
-        result = getopt_long(argc, argv, "mlc:vDhV", long_options, NULL);
+        result = getopt_long(argc, argv, "m::lc:k:vDC:R:hV", long_options, NULL);
         arguments++;
 
         switch(result) {
@@ -875,7 +5205,15 @@ int main(int argc, char *argv[]) {
                         "can not be combined with other options!\n");
                     return EXIT_FAILURE;
                 }
-                conf.monitor = 1;
+                if(optarg == NULL || strcmp(optarg, "text") == 0) {
+                    conf.monitor = MONITOR_TEXT;
+                } else if(strcmp(optarg, "events") == 0) {
+                    conf.monitor = MONITOR_EVENTS;
+                } else {
+                    fprintf(stderr, PROGRAM": unknown monitor format %s!\n",
+                        optarg);
+                    return EXIT_FAILURE;
+                }
                 break;
             case 'l': /* list */
                 if(arguments > 1 || optind < argc) {
@@ -890,12 +5228,21 @@ int main(int argc, char *argv[]) {
             case 'c': /* config */
                 conf.configfile = optarg;
                 break;
+            case 'k': /* cache */
+                conf.cachefile = optarg;
+                break;
             case 'v': /* verbose */
                 conf.verbose = 1;
                 break;
             case 'D': /* no-daemon */
                 conf.daemon = 0;
                 break;
+            case 'C': /* capture */
+                capture = optarg;
+                break;
+            case 'R': /* replay */
+                replay = optarg;
+                break;
             case 'h': /* help */
                 daemon_print_help();
                 break;
@@ -909,8 +5256,24 @@ int main(int argc, char *argv[]) {
 
     if(conf.monitor) {
         input_open_all_listener();
-    } else {
-        config_parse_file();
+        bindings = config_new_bindings();
+    } else if((bindings = config_load()) == NULL) {
+        return EXIT_FAILURE;
+    }
+    conf.global_key_state = bindings->global_key_state;
+    conf.exec_mode = bindings->exec_mode;
+
+    if(replay != NULL) {
+        return (input_replay(replay) < 0) ? EXIT_FAILURE : EXIT_SUCCESS;
+    }
+
+    if(capture != NULL) {
+        if((conf.capture = fopen(capture, "w")) == NULL) {
+            fprintf(stderr, PROGRAM": fopen(%s): %s\n",
+                capture, strerror(errno));
+            return EXIT_FAILURE;
+        }
+        fwrite(TRACE_MAGIC, sizeof(TRACE_MAGIC) - 1, 1, conf.capture);
     }
 
     daemon_start_listener();
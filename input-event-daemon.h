@@ -5,32 +5,199 @@
 #define VERSION  "0.1.3"
 
 #define MAX_MODIFIERS      4
-#define MAX_LISTENER       32
-#define MAX_EVENTS         64
+#define MAX_STEPS          8
+#define SEQUENCE_TIMEOUT   1000000
+#define READ_BATCH         64
+#define FRAME_EVENTS       64
+#define MAX_AXIS_EVENTS    256
+#define EPOLL_BATCH        32
+
+#define ARENA_BLOCK        16384
+#define ARENA_ALIGN        sizeof(void *)
+
+#define LATENCY_BUCKETS    24
+#define REPLAY_EVENTS      1000000
+
+#define TRACE_MAGIC        "IEDTRACE"
+#define CACHE_MAGIC        "IEDCACHE"
+#define CACHE_DATA         64
+#define TRACE_DEVICE       0xffff
+
+/* physical path of the devices created via uinput, never matched by rules */
+#define UINPUT_PHYS        PROGRAM"/uinput"
+
+#define MODIFIER_CTRL      (1 << 0)
+#define MODIFIER_ALT       (1 << 1)
+#define MODIFIER_SHIFT     (1 << 2)
+#define MODIFIER_META      (1 << 3)
 
 #define IDLE_RESET         0x00
 
-#define test_bit(array, bit) ((array)[(bit)/8] & (1 << ((bit)%8)))
+#define GESTURE_PRESS      0
+#define GESTURE_RELEASE    1
+#define GESTURE_HOLD       2
+#define GESTURE_DOUBLE     3
+#define GESTURES           4
+
+#define GESTURE_HOLD_US    500000
+#define GESTURE_DOUBLE_US  300000
+
+#define GESTURE_IDLE       0
+#define GESTURE_DOWN       1
+#define GESTURE_UP         2
+#define GESTURE_DONE       3
+
+#define MONITOR_TEXT       1
+#define MONITOR_EVENTS     2
+#define MONITOR_RING       65536
+#define MONITOR_LINE       512
+
+#define EXEC_SHELL         0
+#define EXEC_DIRECT        1
+#define EXEC_HELPER        2
+#define EXEC_BUILTIN       3
+#define EXEC_MODES         4
+
+#define EXEC_DEBOUNCED     1
+#define EXEC_BUSY          2
+
+#define BUILTIN_WRITE      1
+#define BUILTIN_SEND       2
+#define BUILTIN_EMIT       3
+#define BUILTIN_LED        4
+
+#define SHELL_CHARS        "|&;<>()$`\\\"'*?[]#~=%{}!\n"
+
+#define test_bit(array, bit)  ((array)[(bit)/8] &   (1 << ((bit)%8)))
+#define set_bit(array, bit)   ((array)[(bit)/8] |=  (1 << ((bit)%8)))
+#define clear_bit(array, bit) ((array)[(bit)/8] &= ~(1 << ((bit)%8)))
+
+/* kernel headers before 4.16 only have struct timeval */
+#ifndef input_event_sec
+#define input_event_sec    time.tv_sec
+#define input_event_usec   time.tv_usec
+#endif
 
 /**
- * Global Configuration 
+ * Arena
  *
  */
 
-struct {
-    const char      *configfile;
+typedef struct arena_block {
+    struct arena_block  *next;
+    size_t              size;
+    size_t              used;
+    char                data[] __attribute__ ((aligned(ARENA_ALIGN)));
+} arena_block_t;
 
-    unsigned char   monitor;
-    unsigned char   verbose;
-    unsigned char   daemon;
+typedef struct arena {
+    arena_block_t   *head;
+} arena_t;
 
-    unsigned long   min_timeout;
+/**
+ * Command Execution
+ *
+ */
 
-    const char      *listen[MAX_LISTENER];
-    int             listen_fd[MAX_LISTENER];
+typedef struct limit {
+    unsigned long long  debounce_us;
+    unsigned short      max;
+    unsigned char       coalesce;
+    unsigned char       repeat;
+    unsigned long long  repeat_us;
 
-    struct termios  terminal;
-} conf;
+    unsigned long long  last_us;
+    unsigned long long  repeat_last_us;
+    unsigned short      running;
+    unsigned char       pending;
+
+    signed int          hysteresis;
+    unsigned long long  timeout_us;
+
+    unsigned char       gesture;
+    unsigned long long  gesture_us;
+} limit_t;
+
+typedef struct builtin {
+    unsigned char   type;
+    const char      *path;
+    const char      *data;
+    size_t          length;
+    unsigned short  code;
+    int             value;
+} builtin_t;
+
+typedef struct command {
+    const char      *line;
+    char            **argv;
+    limit_t         *limit;
+    builtin_t       *builtin;
+} command_t;
+
+typedef struct child {
+    pid_t           pid;
+    limit_t         *limit;
+} child_t;
+
+typedef struct latency {
+    unsigned long       count;
+    unsigned long long  total_us;
+    unsigned long long  max_us;
+    unsigned long       bucket[LATENCY_BUCKETS];
+} latency_t;
+
+typedef struct exec_stat {
+    unsigned long       failed;
+    latency_t           latency;
+} exec_stat_t;
+
+static const char *EXEC_MODE_NAME[EXEC_MODES] = {
+    [EXEC_SHELL]  = "shell",
+    [EXEC_DIRECT] = "direct",
+    [EXEC_HELPER] = "helper",
+    [EXEC_BUILTIN] = "builtin",
+};
+
+static const char *GESTURE_NAME[GESTURES] = {
+    [GESTURE_PRESS]   = "press",
+    [GESTURE_RELEASE] = "release",
+    [GESTURE_HOLD]    = "hold",
+    [GESTURE_DOUBLE]  = "double",
+};
+
+static const char *LED_NAME[LED_CNT] = {
+    [LED_NUML]     = "NUML",
+    [LED_CAPSL]    = "CAPSL",
+    [LED_SCROLLL]  = "SCROLLL",
+    [LED_COMPOSE]  = "COMPOSE",
+    [LED_KANA]     = "KANA",
+    [LED_SLEEP]    = "SLEEP",
+    [LED_SUSPEND]  = "SUSPEND",
+    [LED_MUTE]     = "MUTE",
+    [LED_MISC]     = "MISC",
+    [LED_MAIL]     = "MAIL",
+    [LED_CHARGING] = "CHARGING",
+};
+
+/**
+ * Event Traces
+ *
+ * A trace starts with TRACE_MAGIC followed by records in host byte order.
+ * Records of type TRACE_DEVICE announce a device id and are followed by
+ * 'length' bytes: struct input_id, the device path, the device name, the
+ * physical path and the supported event types in hex, all NUL-terminated.
+ * Older traces end after the name.
+ */
+
+typedef struct trace_record {
+    uint32_t        sec;
+    uint32_t        usec;
+    uint16_t        device;
+    uint16_t        type;
+    uint16_t        code;
+    uint16_t        length;
+    int32_t         value;
+} trace_record_t;
 
 /**
  * Event Structs 
@@ -38,36 +205,291 @@ struct {
  */
 
 typedef struct key_event {
-    const char *code;
-    const char *modifiers[MAX_MODIFIERS];
-    size_t     modifier_n;
-    const char *exec;
+    unsigned short  code;
+    unsigned short  modifier_mask;
+    unsigned short  modifiers[MAX_MODIFIERS];
+    size_t          modifier_n;
+    unsigned char   gesture;
+    unsigned short  scope;
+    command_t       exec;
 } key_event_t;
 
 
+/* one node of the sequence trie, reached from 'parent' (0 is the root) by
+ * the chord 'step', whose command runs if no further step follows */
+typedef struct sequence_event {
+    unsigned int        parent;
+    unsigned int        children;
+    unsigned long long  timeout_us;
+    key_event_t         step;
+} sequence_event_t;
+
 typedef struct idle_event {
     unsigned long timeout;
-    const char  *exec;
+    command_t   exec;
 } idle_event_t;
 
 typedef struct switch_event {
-    const char *code;
-    signed int value;
-    const char *exec;
+    signed int     code;
+    signed int     value;
+    unsigned short scope;
+    command_t      exec;
 } switch_event_t;
 
+typedef struct axis_event {
+    unsigned short  type;
+    unsigned short  code;
+    signed int      threshold;
+    unsigned char   below;
+    command_t       exec;
+} axis_event_t;
+
+/**
+ * Listener
+ *
+ */
+
+typedef struct key_state {
+    unsigned char   down[KEY_CNT/8 + 1];
+    key_event_t     current;
+
+    /* node of a started sequence and when it times out */
+    unsigned int        sequence;
+    unsigned long long  sequence_deadline;
+
+    /* key whose press was taken by a started sequence, if any */
+    unsigned short      sequence_taken;
+
+    /* single key with release, hold or double bindings, see GESTURE_IDLE */
+    unsigned short      gesture_code;
+    unsigned char       gesture_phase;
+    unsigned long long  gesture_deadline;
+} key_state_t;
+
+typedef struct axis_state {
+    signed int          rel[REL_CNT];
+    signed int          abs[ABS_CNT];
+    unsigned int        rel_changed;
+    unsigned long long  abs_changed;
+
+    /* absolute bindings which fired and wait for the axis to move back,
+     * by index into bindings->axis_events */
+    unsigned char       latched[MAX_AXIS_EVENTS/8];
+} axis_state_t;
+
+typedef struct listener {
+    const char      *path;
+    int             fd;
+    unsigned char   monotonic;
+    unsigned long   read_count;
+    unsigned long   event_count;
+    unsigned short  trace_id;
+    key_state_t     keys;
+    axis_state_t    axes;
+    unsigned char   switches[SW_CNT/8 + 1];
+
+    /* key and switch events up to the next SYN_REPORT, all if grabbed */
+    struct input_event  frame[FRAME_EVENTS + 1];
+    size_t              frame_n;
+    unsigned char       dropped;
+
+    /* grabbed devices pass what is not bound on to a uinput clone */
+    unsigned char   grab;
+    int             clone_fd;
+    unsigned char   consumed[KEY_CNT/8 + 1];
+
+    /* first matching device rule, 0 if none, and whether it was found
+     * by a rule instead of a 'listen' path */
+    unsigned short  scope;
+    unsigned char   matched;
+} listener_t;
+
+/**
+ * Global Configuration 
+ *
+ */
+
+struct {
+    const char      *configfile;
+    const char      *cachefile;
+
+    unsigned char   monitor;
+    unsigned char   verbose;
+    unsigned char   daemon;
+    unsigned char   quit;
+
+    unsigned long   read_count;
+    unsigned long   event_count;
+    unsigned long   key_matched;
+    unsigned long   sequence_matched;
+    unsigned long   switch_matched;
+    unsigned long   axis_matched;
+    unsigned long   resync_count;
+    unsigned long   idle_fired;
+
+    char            monitor_ring[MONITOR_RING];
+    size_t          monitor_head;
+    size_t          monitor_len;
+    unsigned long   monitor_dropped;
+    unsigned long   monitor_reported;
+    int             monitor_fd;
+    int             monitor_flags;
+    unsigned char   monitor_polled;
+
+    unsigned long long  start_us;
+    unsigned long long  event_us;
+    listener_t          *source;
+    latency_t           dispatch;
+    latency_t           passthrough;
+
+    FILE            *capture;
+    unsigned short  trace_devices;
+    unsigned char   replay;
+
+    unsigned char               exec_mode;
+    int                         helper_fd;
+    int                         uinput_fd;
+    pid_t                       helper_pid;
+    posix_spawnattr_t           spawn_attr;
+    posix_spawn_file_actions_t  spawn_actions;
+    exec_stat_t                 exec_stats[EXEC_MODES];
+    unsigned long               exec_dropped;
+    unsigned long               exec_deferred;
+    child_t                     *children;
+    size_t                      child_n;
+    size_t                      child_max;
+    const command_t             **pending;
+    size_t                      pending_n;
+    size_t                      pending_max;
+
+    listener_t      **listener;
+    size_t          listener_n;
+    size_t          listener_max;
+    unsigned char   listen_all;
+
+    unsigned char   global_key_state;
+    key_state_t     key_state;
+    int             epoll_fd;
+
+    int             inotify_fd;
+    int             signal_fd;
+    int             timer_fd;
+    struct {
+        int         wd;
+        const char  *dir;
+    }               *watch;
+    size_t          watch_n;
+    size_t          watch_max;
+
+    unsigned long long  timer_deadline;
+    unsigned long long  idle_last;
+    unsigned long long  input_last;
+    size_t              idle_next;
+    unsigned char       idle;
+
+    struct termios  terminal;
+} conf;
+
 /**
  * Event Lists 
  *
  */
 
-key_event_t       key_events[MAX_EVENTS];
-idle_event_t     idle_events[MAX_EVENTS];
-switch_event_t switch_events[MAX_EVENTS];
+typedef struct listen {
+    const char      *path;
+    unsigned char   grab;
+} listen_t;
+
+/* a device rule, evaluated whenever a device is opened */
+typedef struct device {
+    const char      *label;
+    const char      *name;
+    const char      *phys;
+    signed int      vendor;
+    signed int      product;
+    unsigned int    caps;
+    unsigned char   grab;
+} device_t;
+
+typedef struct bindings {
+    arena_t         arena;
+
+    key_event_t     *key_events;
+    unsigned int    *key_event_table;
+    sequence_event_t *sequence_events;
+    unsigned int    *sequence_event_table;
+    idle_event_t    *idle_events;
+    switch_event_t  *switch_events;
+    axis_event_t    *axis_events;
 
-size_t    key_event_n = 0;
-size_t   idle_event_n = 0;
-size_t switch_event_n = 0;
+    size_t          key_event_n;
+    size_t          repeat_n;
+    size_t          sequence_event_n;
+    size_t          idle_event_n;
+    size_t          switch_event_n;
+    size_t          axis_event_n;
+
+    size_t          key_event_table_size;
+    size_t          key_event_max;
+    size_t          sequence_event_table_size;
+    size_t          sequence_event_max;
+    size_t          idle_event_max;
+    size_t          switch_event_max;
+    size_t          axis_event_max;
+
+    /* keys with release, hold or double bindings */
+    unsigned char   gesture_keys[KEY_CNT/8 + 1];
+    size_t          gesture_n;
+
+    /* axes with bindings, others are not accumulated */
+    unsigned int        rel_mask;
+    unsigned long long  abs_mask;
+
+    listen_t        *listen;
+    size_t          listen_n;
+    size_t          listen_max;
+
+    device_t        *devices;
+    size_t          device_n;
+    size_t          device_max;
+
+    const char      *stats_file;
+
+    /* [Global] options, applied when the bindings are taken into use */
+    unsigned char   global_key_state;
+    unsigned char   exec_mode;
+
+    size_t          error_n;
+    void            *mapping;
+    size_t          mapping_size;
+} bindings_t;
+
+/**
+ * Configuration Cache
+ *
+ * The file given with --cache holds a header followed, at offset CACHE_DATA,
+ * by a copy of the bindings with all pointers stored as offsets from its
+ * start. It is only valid for the same build layout and an unchanged
+ * configuration file, and every offset, count and code is checked before
+ * it is used.
+ */
+
+#define CACHE_LAYOUT  ((uint32_t) (9 << 24 | sizeof(bindings_t) << 12 | \
+    (sizeof(key_event_t) + sizeof(command_t) + sizeof(limit_t) + \
+     sizeof(builtin_t) + sizeof(switch_event_t) + sizeof(idle_event_t) + \
+     sizeof(axis_event_t) + sizeof(sequence_event_t) + sizeof(device_t))))
+
+typedef struct cache_header {
+    char            magic[8];
+    uint32_t        layout;
+    uint32_t        size;
+    uint64_t        config_size;
+    uint64_t        config_ino;
+    int64_t         config_mtime_sec;
+    int64_t         config_mtime_nsec;
+} cache_header_t;
+
+bindings_t *bindings = NULL;
 
 /**
  * Functions 
@@ -76,41 +498,228 @@ size_t switch_event_n = 0;
 
 static int
     key_event_compare(const key_event_t *a, const key_event_t *b);
+static unsigned int
+    key_event_hash(const key_event_t *key_event, unsigned int scope);
+static key_event_t
+    *key_event_lookup(const key_event_t *key_event);
+static int
+    key_event_insert(bindings_t *new, size_t index);
 static const char
     *key_event_name(unsigned int code);
-static const char
-    *key_event_modifier_name(const char* code);
-static key_event_t 
-    *key_event_parse(unsigned int code, int pressed, const char *src);
+static int
+    key_event_code(const char *name);
+static unsigned int
+    key_event_modifier(unsigned int code);
+static size_t
+    key_event_format(char *buffer, size_t size, const key_event_t *key_event);
+static int
+    key_event_modifier_down(const key_state_t *state, unsigned int modifier);
+static key_event_t
+    *key_event_parse(unsigned int code, int pressed, key_state_t *state,
+        const char *src);
+static key_event_t
+    *key_event_repeat(unsigned int code, key_state_t *state, const char *src);
+static void
+    key_event_report(const key_event_t *key_event, const char *src,
+        const char *kind);
+
+
+static key_event_t
+    *gesture_event_lookup(unsigned int code, unsigned int gesture,
+        unsigned int scope);
+static void
+    gesture_event_key(unsigned int code, int pressed, key_state_t *state,
+        const char *src);
+static void
+    gesture_event_fire(const key_state_t *state, unsigned int code,
+        unsigned int gesture, const char *src);
+static void gesture_event_timeout(key_state_t *state, const char *src);
+static unsigned long long gesture_event_expire(unsigned long long now);
+
+
+static unsigned int
+    sequence_event_hash(unsigned int parent, const key_event_t *step);
+static unsigned int
+    sequence_event_lookup(const bindings_t *b, unsigned int parent,
+        const key_event_t *step);
+static void sequence_event_insert(bindings_t *new, unsigned int node);
+static int  sequence_event_advance(key_state_t *state, const char *src);
+static int  sequence_event_step(const key_state_t *state);
+static unsigned long long sequence_event_expire(unsigned long long now);
+static size_t
+    sequence_event_format(char *buffer, size_t size, unsigned int node);
 
 
 static int idle_event_compare(const idle_event_t *a, const idle_event_t *b);
-static int idle_event_parse(unsigned long idle);
+static void idle_event_exec(const idle_event_t *idle_event);
+static void idle_event_schedule(unsigned long long now);
+static unsigned long long idle_event_deadline();
+static void idle_event_reset();
+static void idle_event_activity(unsigned long long last);
+static void idle_event_expire(unsigned long long now);
 
 
 static int
     switch_event_compare(const switch_event_t *a, const switch_event_t *b);
 static const char
     *switch_event_name(unsigned int code);
+static int  switch_event_code(const char *name);
 static switch_event_t
-    *switch_event_parse(unsigned int code, int value, const char *src);
+    *switch_event_parse(unsigned int code, int value, unsigned int scope,
+        const char *src);
+
+
+static int
+    axis_event_compare(const axis_event_t *a, const axis_event_t *b);
+static const char
+    *axis_event_name(unsigned int type, unsigned int code);
+static int  axis_event_code(unsigned int type, const char *name);
+static void axis_event_update(const struct input_event *event,
+    axis_state_t *axes);
+static void axis_event_frame(axis_state_t *axes, const char *src);
+static void
+    axis_event_dispatch(axis_state_t *axes, unsigned int type,
+        unsigned int code, int value, const char *src);
+static void
+    axis_event_report(const axis_event_t *axis_event, int value,
+        const char *src);
 
 
 void        input_open_all_listener();
 void        input_list_devices();
-static void input_parse_event(struct input_event *event, const char *src);
+static listener_t *input_add_listener(const char *path);
+static unsigned int input_match_device(int fd);
+static unsigned int
+    input_match_rules(const char *name, const char *phys,
+        const struct input_id *id, unsigned int caps);
+static unsigned int input_device_caps(int fd);
+static void input_match_all();
+static listener_t *input_match_path(const char *path);
+static void input_remove_listener(listener_t *listener);
+static int  input_open_listener(listener_t *listener);
+static void input_close_listener(listener_t *listener);
+static void input_watch_directory(const char *path);
+static void input_hotplug();
+static int  input_read_events(listener_t *listener);
+static void input_parse_event(struct input_event *event, listener_t *listener);
+static void input_frame_event(struct input_event *event, listener_t *listener);
+static void input_frame_flush(listener_t *listener);
+static void input_frame_add(listener_t *listener,
+    const struct input_event *event);
+static int  input_frame_consumed(listener_t *listener,
+    const struct input_event *event);
+static void input_resync(listener_t *listener);
+static int  input_grab_listener(listener_t *listener);
+static void input_capture_device(listener_t *listener);
+static void
+    input_capture_events(listener_t *listener, const struct input_event *events,
+        size_t n);
+static int  input_replay_compare(const void *a, const void *b);
+static int
+    input_replay_scope(listener_t *listener, const char *info, size_t length);
+static int  input_replay(const char *path);
+
 
+static void monitor_init();
+static void monitor_printf(const char *format, ...)
+    __attribute__ ((format (printf, 1, 2)));
+static void monitor_event(const struct input_event *event, listener_t *listener);
+static int  monitor_flush();
+static void monitor_clean();
 
-void                config_parse_file();
-static const char   *config_key_event(char *shortcut, char *exec);
-static const char   *config_idle_event(char *timeout, char *exec);
-static const char   *config_switch_event(char *switchcode, char *exec);
-static unsigned int config_min_timeout(unsigned long a, unsigned long b);
+
+static void         *arena_alloc(arena_t *arena, size_t size);
+static void         *arena_memdup(arena_t *arena, const void *ptr, size_t size);
+static char         *arena_strdup(arena_t *arena, const char *str);
+static void         *arena_move(arena_t *arena, void *ptr, size_t size);
+static void         arena_free(arena_t *arena);
+
+static bindings_t   *config_new_bindings();
+bindings_t          *config_parse_file();
+static void         config_pack_bindings(bindings_t *new);
+static void         config_free_bindings(bindings_t *old);
+static bindings_t   *config_load();
+static bindings_t
+    *config_cache_read(const char *path, const struct stat *st);
+static void
+    config_cache_write(const char *path, const struct stat *st,
+        const bindings_t *bindings);
+static void         config_cache_command(arena_t *arena, command_t *command);
+static int
+    config_cache_check(const char *base, size_t size);
+static int
+    config_cache_check_table(const unsigned int *table, size_t size,
+        size_t n);
+static int
+    config_cache_check_key(const bindings_t *b, const key_event_t *event);
+static int
+    config_cache_check_command(const char *base, size_t size,
+        const command_t *command);
+static void
+    config_cache_relocate_command(command_t *command, intptr_t delta);
+static void         config_cache_relocate(bindings_t *b, intptr_t delta);
+static void
+    *config_grow(void *array, size_t n, size_t *max, size_t size);
+static const char
+    *config_key_chord(char *shortcut, key_event_t *key_event);
+static const char
+    *config_key_event(bindings_t *new, char *shortcut, char *exec,
+        limit_t *limit, unsigned int scope);
+static const char
+    *config_sequence_event(bindings_t *new, char *sequence, char *exec,
+        limit_t *limit);
+static const char
+    *config_idle_event(bindings_t *new, char *timeout, char *exec);
+static const char
+    *config_switch_event(bindings_t *new, char *switchcode, char *exec);
+static const char
+    *config_axis_event(bindings_t *new, unsigned int type, char *axis,
+        char *exec);
+static const char
+    *config_device(bindings_t *new, char *label, char *rules);
+static const char
+    *config_limit(bindings_t *new, char *key, limit_t **limit);
+static int          config_duration(const char *str, unsigned long long *us);
+static const char
+    *config_command(arena_t *arena, command_t *command, const char *line);
+static const char
+    *config_builtin(arena_t *arena, command_t *command, const char *line);
 static char         *config_trim_string(char *str);
+static int          config_code_compare(const void *name, const void *entry);
 
 void        daemon_init();
 void        daemon_start_listener();
-static void daemon_exec(const char *command);
+static void daemon_signal();
+static void daemon_reload();
+static void daemon_timer_arm(unsigned long long deadline);
+static void daemon_timer_expired();
+static unsigned long long daemon_monotonic_us();
+static void daemon_exec_init();
+static pid_t daemon_exec_spawn(const char *line, char *const *argv);
+static void daemon_exec_helper(int fd);
+static void daemon_exec_helper_close(int keep);
+static int  daemon_exec_helper_start();
+static int  daemon_exec_helper_send(const command_t *command);
+static void daemon_exec(const command_t *command);
+static int  daemon_builtin(const builtin_t *builtin);
+static int
+    daemon_builtin_error(const char *what, const char *path, int error);
+static int  daemon_builtin_send(const builtin_t *builtin);
+static int  daemon_builtin_emit(const builtin_t *builtin);
+static int
+    daemon_builtin_led(const builtin_t *builtin, listener_t *listener);
+static int
+    daemon_exec_blocked(const limit_t *limit, unsigned long long now);
+static int
+    daemon_exec_allowed(const command_t *command, unsigned long long now);
+static void daemon_exec_pending();
+static void daemon_exec_track(pid_t pid, limit_t *limit);
+static void daemon_exec_reap();
+static void daemon_stats_add(latency_t *latency, unsigned long long us);
+static void
+    daemon_stats_print_latency(FILE *stream, const char *name,
+        const latency_t *latency);
+static void daemon_stats_dump();
 void        daemon_clean();
 static void daemon_print_help();
 static void daemon_print_version();
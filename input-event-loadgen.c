@@ -0,0 +1,525 @@
+#define _GNU_SOURCE
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+#include <getopt.h>
+#include <fcntl.h>
+#include <errno.h>
+#include <time.h>
+#include <poll.h>
+#include <signal.h>
+#include <dirent.h>
+#include <limits.h>
+
+#include <sys/ioctl.h>
+#include <sys/stat.h>
+#include <sys/wait.h>
+
+#include <linux/input.h>
+#include <linux/uinput.h>
+
+#include "input-event-table.h"
+
+/**
+ * Synthetic load for input-event-daemon
+ *
+ * Creates a virtual input device via /dev/uinput, starts the daemon with a
+ * generated configuration listening to it and sends key chords or switch
+ * toggles at a fixed rate. Every binding runs a script which writes a line
+ * to a FIFO; the time from sending an action to reading its line is the
+ * end-to-end latency.
+ */
+
+#define PROGRAM  "input-event-loadgen"
+
+#define MAX_ACTIONS        16
+#define MAX_CHORD          8
+#define SETTLE_MS          500
+#define DRAIN_MS           2000
+
+typedef struct action {
+    const char      *name;
+    unsigned short  type;
+    unsigned short  codes[MAX_CHORD];
+    size_t          code_n;
+} action_t;
+
+struct {
+    const char      *daemon;
+    const char      *exec_mode;
+    unsigned long   rate;
+    unsigned long   count;
+
+    action_t        actions[MAX_ACTIONS];
+    size_t          action_n;
+
+    char            dir[64];
+    char            fifo[96];
+    char            script[96];
+    char            config[96];
+    char            device[PATH_MAX];
+
+    int             uinput_fd;
+    int             fifo_fd;
+    pid_t           daemon_pid;
+} gen;
+
+static unsigned long long monotonic_us() {
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+
+    return (unsigned long long) ts.tv_sec * 1000000 + ts.tv_nsec / 1000;
+}
+
+static int compare_ull(const void *a, const void *b) {
+    unsigned long long x = *(const unsigned long long *) a;
+    unsigned long long y = *(const unsigned long long *) b;
+
+    return (x > y) - (x < y);
+}
+
+static int compare_code(const void *name, const void *entry) {
+    return strcasecmp(name, ((const event_code_t *) entry)->name);
+}
+
+/* the same lookup as the daemon, so both accept the same names */
+static int parse_code(const event_code_t *table, size_t n, const char *name) {
+    const event_code_t *entry;
+
+    entry = bsearch(name, table, n, sizeof(event_code_t), compare_code);
+
+    return (entry != NULL) ? entry->code : -1;
+}
+
+static int parse_key(const char *name) {
+    if(strcasecmp(name, "CTRL") == 0)  return KEY_LEFTCTRL;
+    if(strcasecmp(name, "ALT") == 0)   return KEY_LEFTALT;
+    if(strcasecmp(name, "SHIFT") == 0) return KEY_LEFTSHIFT;
+    if(strcasecmp(name, "META") == 0)  return KEY_LEFTMETA;
+
+    return parse_code(KEY_CODE, sizeof(KEY_CODE) / sizeof(KEY_CODE[0]), name);
+}
+
+static const char *parse_action(const char *spec, unsigned short type) {
+    action_t *action;
+    char *copy, *ptr, *save = NULL;
+    int code;
+
+    if(gen.action_n >= MAX_ACTIONS) {
+        return "Too many actions!";
+    }
+    action = &gen.actions[gen.action_n];
+    action->name = spec;
+    action->type = type;
+    action->code_n = 0;
+
+    if(type == EV_SW) {
+        code = parse_code(SW_CODE, sizeof(SW_CODE) / sizeof(SW_CODE[0]), spec);
+        if(code < 0) {
+            return "Unknown switch!";
+        }
+        action->codes[action->code_n++] = code;
+        gen.action_n++;
+        return NULL;
+    }
+
+    copy = strdup(spec);
+    for(ptr = strtok_r(copy, "+", &save); ptr; ptr = strtok_r(NULL, "+", &save)) {
+        if((code = parse_key(ptr)) < 0) {
+            free(copy);
+            return "Unknown key!";
+        }
+        if(action->code_n >= MAX_CHORD) {
+            free(copy);
+            return "Chord too long!";
+        }
+        action->codes[action->code_n++] = code;
+    }
+    free(copy);
+
+    if(action->code_n == 0) {
+        return "Empty chord!";
+    }
+    gen.action_n++;
+
+    return NULL;
+}
+
+static void emit(unsigned short type, unsigned short code, int value) {
+    struct input_event event[2];
+
+    memset(event, 0, sizeof(event));
+    event[0].type  = type;
+    event[0].code  = code;
+    event[0].value = value;
+    event[1].type  = EV_SYN;
+    event[1].code  = SYN_REPORT;
+
+    if(write(gen.uinput_fd, event, sizeof(event)) != sizeof(event)) {
+        perror(PROGRAM": write(uinput)");
+        exit(EXIT_FAILURE);
+    }
+}
+
+static void send_action(const action_t *action, unsigned long n) {
+    size_t i;
+
+    if(action->type == EV_SW) {
+        /* every toggle changes the state, both values are bound */
+        emit(EV_SW, action->codes[0], !(n / gen.action_n % 2));
+        return;
+    }
+
+    for(i=0; i < action->code_n; i++) {
+        emit(EV_KEY, action->codes[i], 1);
+    }
+    for(i=action->code_n; i > 0; i--) {
+        emit(EV_KEY, action->codes[i-1], 0);
+    }
+}
+
+static void create_device() {
+    struct uinput_user_dev dev;
+    char sysname[32], path[128];
+    struct dirent *entry;
+    DIR *dir;
+    size_t i, j;
+    int tries;
+
+    if((gen.uinput_fd = open("/dev/uinput", O_WRONLY | O_NONBLOCK)) < 0) {
+        perror(PROGRAM": open(/dev/uinput)");
+        exit(EXIT_FAILURE);
+    }
+
+    ioctl(gen.uinput_fd, UI_SET_EVBIT, EV_SYN);
+    for(i=0; i < gen.action_n; i++) {
+        ioctl(gen.uinput_fd, UI_SET_EVBIT, gen.actions[i].type);
+        for(j=0; j < gen.actions[i].code_n; j++) {
+            ioctl(gen.uinput_fd, (gen.actions[i].type == EV_SW) ?
+                UI_SET_SWBIT : UI_SET_KEYBIT, gen.actions[i].codes[j]);
+        }
+    }
+
+    memset(&dev, 0, sizeof(dev));
+    snprintf(dev.name, UINPUT_MAX_NAME_SIZE, PROGRAM);
+    dev.id.bustype = BUS_VIRTUAL;
+
+    if(
+        write(gen.uinput_fd, &dev, sizeof(dev)) != sizeof(dev) ||
+        ioctl(gen.uinput_fd, UI_DEV_CREATE) < 0
+    ) {
+        perror(PROGRAM": uinput");
+        exit(EXIT_FAILURE);
+    }
+
+    if(ioctl(gen.uinput_fd, UI_GET_SYSNAME(sizeof(sysname)), sysname) < 0) {
+        perror(PROGRAM": UI_GET_SYSNAME");
+        exit(EXIT_FAILURE);
+    }
+
+    /* the event device is a child of the input device in sysfs */
+    snprintf(path, sizeof(path), "/sys/devices/virtual/input/%s", sysname);
+    if((dir = opendir(path)) == NULL) {
+        fprintf(stderr, PROGRAM": opendir(%s): %s\n", path, strerror(errno));
+        exit(EXIT_FAILURE);
+    }
+    while((entry = readdir(dir)) != NULL) {
+        if(strncmp(entry->d_name, "event", 5) == 0) {
+            snprintf(gen.device, sizeof(gen.device), "/dev/input/%s",
+                entry->d_name);
+            break;
+        }
+    }
+    closedir(dir);
+
+    if(gen.device[0] == '\0') {
+        fprintf(stderr, PROGRAM": no event device for %s\n", sysname);
+        exit(EXIT_FAILURE);
+    }
+
+    /* wait for udev to create the device node */
+    for(tries=0; access(gen.device, R_OK) != 0 && tries < 100; tries++) {
+        usleep(10000);
+    }
+}
+
+static void write_config() {
+    FILE *file;
+    size_t i;
+
+    snprintf(gen.fifo, sizeof(gen.fifo), "%s/done", gen.dir);
+    snprintf(gen.script, sizeof(gen.script), "%s/done.sh", gen.dir);
+    snprintf(gen.config, sizeof(gen.config), "%s/loadgen.conf", gen.dir);
+
+    if(mkfifo(gen.fifo, 0600) < 0) {
+        perror(PROGRAM": mkfifo()");
+        exit(EXIT_FAILURE);
+    }
+
+    /* O_RDWR keeps the FIFO open between two writers */
+    if((gen.fifo_fd = open(gen.fifo, O_RDWR | O_NONBLOCK)) < 0) {
+        perror(PROGRAM": open(fifo)");
+        exit(EXIT_FAILURE);
+    }
+
+    if((file = fopen(gen.script, "w")) == NULL) {
+        perror(PROGRAM": fopen(script)");
+        exit(EXIT_FAILURE);
+    }
+    fprintf(file, "echo >> %s\n", gen.fifo);
+    fclose(file);
+
+    if((file = fopen(gen.config, "w")) == NULL) {
+        perror(PROGRAM": fopen(config)");
+        exit(EXIT_FAILURE);
+    }
+
+    /* the command has no shell syntax, so every exec mode can run it */
+    fprintf(file, "[Global]\nlisten = %s\n", gen.device);
+    if(gen.exec_mode != NULL) {
+        fprintf(file, "exec_mode = %s\n", gen.exec_mode);
+    }
+
+    fprintf(file, "\n[Keys]\n");
+    for(i=0; i < gen.action_n; i++) {
+        if(gen.actions[i].type == EV_KEY) {
+            fprintf(file, "%s = /bin/sh %s\n", gen.actions[i].name, gen.script);
+        }
+    }
+
+    fprintf(file, "\n[Switches]\n");
+    for(i=0; i < gen.action_n; i++) {
+        if(gen.actions[i].type == EV_SW) {
+            fprintf(file, "%s:0 = /bin/sh %s\n", gen.actions[i].name, gen.script);
+            fprintf(file, "%s:1 = /bin/sh %s\n", gen.actions[i].name, gen.script);
+        }
+    }
+    fclose(file);
+}
+
+static void start_daemon() {
+    if((gen.daemon_pid = fork()) < 0) {
+        perror(PROGRAM": fork()");
+        exit(EXIT_FAILURE);
+    } else if(gen.daemon_pid == 0) {
+        execl(gen.daemon, gen.daemon, "--no-daemon",
+            "--config", gen.config, (char *) NULL);
+        fprintf(stderr, PROGRAM": exec(%s): %s\n", gen.daemon, strerror(errno));
+        _exit(EXIT_FAILURE);
+    }
+
+    /* there is no readiness notification, give it time to open the device */
+    usleep(SETTLE_MS * 1000);
+}
+
+static void cleanup() {
+    if(gen.daemon_pid > 0) {
+        kill(gen.daemon_pid, SIGTERM);
+        waitpid(gen.daemon_pid, NULL, 0);
+        gen.daemon_pid = 0;
+    }
+
+    if(gen.uinput_fd >= 0) {
+        ioctl(gen.uinput_fd, UI_DEV_DESTROY);
+        close(gen.uinput_fd);
+        gen.uinput_fd = -1;
+    }
+
+    if(gen.dir[0] != '\0') {
+        unlink(gen.fifo);
+        unlink(gen.script);
+        unlink(gen.config);
+        rmdir(gen.dir);
+    }
+}
+
+static void run() {
+    unsigned long long *sent, *latency, start, next, now, deadline;
+    unsigned long n = 0, done = 0;
+    struct pollfd pfd = { .fd = gen.fifo_fd, .events = POLLIN };
+    char buffer[256];
+    ssize_t len, i;
+    int timeout;
+
+    sent    = calloc(gen.count, sizeof(unsigned long long));
+    latency = calloc(gen.count, sizeof(unsigned long long));
+    if(sent == NULL || latency == NULL) {
+        perror(PROGRAM": calloc()");
+        exit(EXIT_FAILURE);
+    }
+
+    /* switch states are replayed when the daemon opens the device */
+    while(read(gen.fifo_fd, buffer, sizeof(buffer)) > 0);
+
+    start = next = monotonic_us();
+    deadline = 0;
+
+    while(done < gen.count) {
+        now = monotonic_us();
+
+        if(n < gen.count && now >= next) {
+            sent[n] = now;
+            send_action(&gen.actions[n % gen.action_n], n);
+            n++;
+            next = start + n * 1000000ULL / gen.rate;
+
+            if(n == gen.count) {
+                deadline = monotonic_us() + DRAIN_MS * 1000ULL;
+            }
+            continue;
+        }
+
+        if(n < gen.count) {
+            timeout = (next - now + 999) / 1000;
+        } else if(now < deadline) {
+            timeout = (deadline - now + 999) / 1000;
+        } else {
+            break;
+        }
+
+        if(poll(&pfd, 1, timeout) <= 0) {
+            continue;
+        }
+
+        now = monotonic_us();
+        while((len = read(gen.fifo_fd, buffer, sizeof(buffer))) > 0) {
+            /* completions are matched to actions in order */
+            for(i=0; i < len; i++) {
+                if(buffer[i] == '\n' && done < n) {
+                    latency[done] = now - sent[done];
+                    done++;
+                }
+            }
+        }
+    }
+
+    now = monotonic_us();
+
+    printf("%s: %lu actions at %lu/s on %s\n",
+        PROGRAM, gen.count, gen.rate, gen.device);
+    printf("  completed: %lu, lost %lu\n", done, gen.count - done);
+
+    if(done > 0) {
+        qsort(latency, done, sizeof(unsigned long long), compare_ull);
+        printf("  rate     : %.1f actions/s\n",
+            done * 1000000.0 / (now - start));
+        printf("  latency  : p50 %llu us, p90 %llu us, p99 %llu us, "
+            "max %llu us\n",
+            latency[done / 2], latency[done * 9 / 10],
+            latency[done * 99 / 100], latency[done - 1]);
+    }
+
+    free(sent);
+    free(latency);
+}
+
+static void print_help() {
+    printf("Usage:\n\n"
+            "    "PROGRAM" [--key=CHORD]... [--switch=NAME]... [--rate=N]\n"
+            "                        [--count=N] [--exec-mode=MODE] "
+            "[--daemon=FILE]\n"
+            "\n"
+            "Available Options:\n"
+            "\n"
+            "    -k, --key CHORD      Send key chord, e.g. CTRL+ALT+F1\n"
+            "    -w, --switch NAME    Toggle switch, e.g. LID\n"
+            "    -r, --rate N         Actions per second (default: 100)\n"
+            "    -n, --count N        Number of actions (default: 1000)\n"
+            "    -e, --exec-mode MODE exec_mode of the daemon\n"
+            "    -d, --daemon FILE    Daemon binary "
+            "(default: ./input-event-daemon)\n"
+            "\n"
+            "    -h, --help           Show this help and quit\n"
+            "\n"
+    );
+    exit(EXIT_SUCCESS);
+}
+
+int main(int argc, char *argv[]) {
+    int result;
+    const char *error;
+    static const struct option long_options[] = {
+        { "key",       required_argument, 0, 'k' },
+        { "switch",    required_argument, 0, 'w' },
+        { "rate",      required_argument, 0, 'r' },
+        { "count",     required_argument, 0, 'n' },
+        { "exec-mode", required_argument, 0, 'e' },
+        { "daemon",    required_argument, 0, 'd' },
+        { "help",      no_argument,       0, 'h' },
+        {NULL,         0,              NULL,  0  }
+    };
+
+    gen.daemon     = "./input-event-daemon";
+    gen.exec_mode  = NULL;
+    gen.rate       = 100;
+    gen.count      = 1000;
+    gen.uinput_fd  = -1;
+    gen.fifo_fd    = -1;
+    gen.daemon_pid = 0;
+
+    while((result = getopt_long(argc, argv, "k:w:r:n:e:d:h",
+        long_options, NULL)) != -1) {
+        error = NULL;
+
+        switch(result) {
+            case 'k': /* key */
+                error = parse_action(optarg, EV_KEY);
+                break;
+            case 'w': /* switch */
+                error = parse_action(optarg, EV_SW);
+                break;
+            case 'r': /* rate */
+                gen.rate = strtoul(optarg, NULL, 10);
+                break;
+            case 'n': /* count */
+                gen.count = strtoul(optarg, NULL, 10);
+                break;
+            case 'e': /* exec-mode */
+                gen.exec_mode = optarg;
+                break;
+            case 'd': /* daemon */
+                gen.daemon = optarg;
+                break;
+            case 'h': /* help */
+                print_help();
+                break;
+            default: /* unknown */
+                return EXIT_FAILURE;
+        }
+
+        if(error != NULL) {
+            fprintf(stderr, PROGRAM": %s (%s)\n", error, optarg);
+            return EXIT_FAILURE;
+        }
+    }
+
+    if(gen.rate == 0 || gen.count == 0) {
+        fprintf(stderr, PROGRAM": rate and count must be positive!\n");
+        return EXIT_FAILURE;
+    }
+
+    if(gen.action_n == 0) {
+        parse_action("CTRL+F12", EV_KEY);
+    }
+
+    snprintf(gen.dir, sizeof(gen.dir), "/tmp/"PROGRAM".XXXXXX");
+    if(mkdtemp(gen.dir) == NULL) {
+        perror(PROGRAM": mkdtemp()");
+        return EXIT_FAILURE;
+    }
+
+    atexit(cleanup);
+    signal(SIGINT, exit);
+    signal(SIGTERM, exit);
+
+    create_device();
+    write_config();
+    start_daemon();
+    run();
+
+    return EXIT_SUCCESS;
+}
@@ -1,6 +1,11 @@
 #include <linux/input.h>
 
-static const char *KEY_NAME[KEY_CNT] = {
+typedef struct event_code {
+    const char      *name;
+    unsigned short  code;
+} event_code_t;
+
+static const char *KEY_NAME[KEY_CNT] __attribute__((unused)) = {
     [KEY_RESERVED             ] = "RESERVED",
     [KEY_ESC                  ] = "ESC",
     [KEY_1                    ] = "1",
@@ -155,6 +160,7 @@ static const char *KEY_NAME[KEY_CNT] = {
     [KEY_MSDOS                ] = "MSDOS",
     [KEY_COFFEE               ] = "COFFEE",
     [KEY_SCREENLOCK           ] = "SCREENLOCK",
+    [KEY_ROTATE_DISPLAY       ] = "ROTATE_DISPLAY",
     [KEY_DIRECTION            ] = "DIRECTION",
     [KEY_CYCLEWINDOWS         ] = "CYCLEWINDOWS",
     [KEY_MAIL                 ] = "MAIL",
@@ -201,6 +207,7 @@ static const char *KEY_NAME[KEY_CNT] = {
     [KEY_PAUSECD              ] = "PAUSECD",
     [KEY_PROG3                ] = "PROG3",
     [KEY_PROG4                ] = "PROG4",
+    [KEY_ALL_APPLICATIONS     ] = "ALL_APPLICATIONS",
     [KEY_DASHBOARD            ] = "DASHBOARD",
     [KEY_SUSPEND              ] = "SUSPEND",
     [KEY_CLOSE                ] = "CLOSE",
@@ -241,9 +248,13 @@ static const char *KEY_NAME[KEY_CNT] = {
     [KEY_VIDEO_NEXT           ] = "VIDEO_NEXT",
     [KEY_VIDEO_PREV           ] = "VIDEO_PREV",
     [KEY_BRIGHTNESS_CYCLE     ] = "BRIGHTNESS_CYCLE",
+    [KEY_BRIGHTNESS_AUTO      ] = "BRIGHTNESS_AUTO",
     [KEY_BRIGHTNESS_ZERO      ] = "BRIGHTNESS_ZERO",
     [KEY_DISPLAY_OFF          ] = "DISPLAY_OFF",
+    [KEY_WWAN                 ] = "WWAN",
     [KEY_WIMAX                ] = "WIMAX",
+    [KEY_RFKILL               ] = "RFKILL",
+    [KEY_MICMUTE              ] = "MICMUTE",
     [BTN_MISC                 ] = "BTN_MISC",
     [BTN_0                    ] = "BTN_0",
     [BTN_1                    ] = "BTN_1",
@@ -279,10 +290,14 @@ static const char *KEY_NAME[KEY_CNT] = {
     [BTN_BASE6                ] = "BTN_BASE6",
     [BTN_DEAD                 ] = "BTN_DEAD",
     [BTN_GAMEPAD              ] = "BTN_GAMEPAD",
+    [BTN_SOUTH                ] = "BTN_SOUTH",
     [BTN_A                    ] = "BTN_A",
+    [BTN_EAST                 ] = "BTN_EAST",
     [BTN_B                    ] = "BTN_B",
     [BTN_C                    ] = "BTN_C",
+    [BTN_NORTH                ] = "BTN_NORTH",
     [BTN_X                    ] = "BTN_X",
+    [BTN_WEST                 ] = "BTN_WEST",
     [BTN_Y                    ] = "BTN_Y",
     [BTN_Z                    ] = "BTN_Z",
     [BTN_TL                   ] = "BTN_TL",
@@ -303,6 +318,8 @@ static const char *KEY_NAME[KEY_CNT] = {
     [BTN_TOOL_FINGER          ] = "BTN_TOOL_FINGER",
     [BTN_TOOL_MOUSE           ] = "BTN_TOOL_MOUSE",
     [BTN_TOOL_LENS            ] = "BTN_TOOL_LENS",
+    [BTN_TOOL_QUINTTAP        ] = "BTN_TOOL_QUINTTAP",
+    [BTN_STYLUS3              ] = "BTN_STYLUS3",
     [BTN_TOUCH                ] = "BTN_TOUCH",
     [BTN_STYLUS               ] = "BTN_STYLUS",
     [BTN_STYLUS2              ] = "BTN_STYLUS2",
@@ -332,9 +349,11 @@ static const char *KEY_NAME[KEY_CNT] = {
     [KEY_TITLE                ] = "TITLE",
     [KEY_SUBTITLE             ] = "SUBTITLE",
     [KEY_ANGLE                ] = "ANGLE",
+    [KEY_FULL_SCREEN          ] = "FULL_SCREEN",
     [KEY_ZOOM                 ] = "ZOOM",
     [KEY_MODE                 ] = "MODE",
     [KEY_KEYBOARD             ] = "KEYBOARD",
+    [KEY_ASPECT_RATIO         ] = "ASPECT_RATIO",
     [KEY_SCREEN               ] = "SCREEN",
     [KEY_PC                   ] = "PC",
     [KEY_TV                   ] = "TV",
@@ -392,6 +411,7 @@ static const char *KEY_NAME[KEY_CNT] = {
     [KEY_ADDRESSBOOK          ] = "ADDRESSBOOK",
     [KEY_MESSENGER            ] = "MESSENGER",
     [KEY_DISPLAYTOGGLE        ] = "DISPLAYTOGGLE",
+    [KEY_BRIGHTNESS_TOGGLE    ] = "BRIGHTNESS_TOGGLE",
     [KEY_SPELLCHECK           ] = "SPELLCHECK",
     [KEY_LOGOFF               ] = "LOGOFF",
     [KEY_DOLLAR               ] = "DOLLAR",
@@ -400,6 +420,13 @@ static const char *KEY_NAME[KEY_CNT] = {
     [KEY_FRAMEFORWARD         ] = "FRAMEFORWARD",
     [KEY_CONTEXT_MENU         ] = "CONTEXT_MENU",
     [KEY_MEDIA_REPEAT         ] = "MEDIA_REPEAT",
+    [KEY_10CHANNELSUP         ] = "10CHANNELSUP",
+    [KEY_10CHANNELSDOWN       ] = "10CHANNELSDOWN",
+    [KEY_IMAGES               ] = "IMAGES",
+    [KEY_NOTIFICATION_CENTER  ] = "NOTIFICATION_CENTER",
+    [KEY_PICKUP_PHONE         ] = "PICKUP_PHONE",
+    [KEY_HANGUP_PHONE         ] = "HANGUP_PHONE",
+    [KEY_LINK_PHONE           ] = "LINK_PHONE",
     [KEY_DEL_EOL              ] = "DEL_EOL",
     [KEY_DEL_EOS              ] = "DEL_EOS",
     [KEY_INS_LINE             ] = "INS_LINE",
@@ -425,6 +452,7 @@ static const char *KEY_NAME[KEY_CNT] = {
     [KEY_FN_F                 ] = "FN_F",
     [KEY_FN_S                 ] = "FN_S",
     [KEY_FN_B                 ] = "FN_B",
+    [KEY_FN_RIGHT_SHIFT       ] = "FN_RIGHT_SHIFT",
     [KEY_BRL_DOT1             ] = "BRL_DOT1",
     [KEY_BRL_DOT2             ] = "BRL_DOT2",
     [KEY_BRL_DOT3             ] = "BRL_DOT3",
@@ -447,9 +475,234 @@ static const char *KEY_NAME[KEY_CNT] = {
     [KEY_NUMERIC_9            ] = "NUMERIC_9",
     [KEY_NUMERIC_STAR         ] = "NUMERIC_STAR",
     [KEY_NUMERIC_POUND        ] = "NUMERIC_POUND",
+    [KEY_NUMERIC_A            ] = "NUMERIC_A",
+    [KEY_NUMERIC_B            ] = "NUMERIC_B",
+    [KEY_NUMERIC_C            ] = "NUMERIC_C",
+    [KEY_NUMERIC_D            ] = "NUMERIC_D",
+    [KEY_CAMERA_FOCUS         ] = "CAMERA_FOCUS",
+    [KEY_WPS_BUTTON           ] = "WPS_BUTTON",
+    [KEY_TOUCHPAD_TOGGLE      ] = "TOUCHPAD_TOGGLE",
+    [KEY_TOUCHPAD_ON          ] = "TOUCHPAD_ON",
+    [KEY_TOUCHPAD_OFF         ] = "TOUCHPAD_OFF",
+    [KEY_CAMERA_ZOOMIN        ] = "CAMERA_ZOOMIN",
+    [KEY_CAMERA_ZOOMOUT       ] = "CAMERA_ZOOMOUT",
+    [KEY_CAMERA_UP            ] = "CAMERA_UP",
+    [KEY_CAMERA_DOWN          ] = "CAMERA_DOWN",
+    [KEY_CAMERA_LEFT          ] = "CAMERA_LEFT",
+    [KEY_CAMERA_RIGHT         ] = "CAMERA_RIGHT",
+    [KEY_ATTENDANT_ON         ] = "ATTENDANT_ON",
+    [KEY_ATTENDANT_OFF        ] = "ATTENDANT_OFF",
+    [KEY_ATTENDANT_TOGGLE     ] = "ATTENDANT_TOGGLE",
+    [KEY_LIGHTS_TOGGLE        ] = "LIGHTS_TOGGLE",
+    [BTN_DPAD_UP              ] = "BTN_DPAD_UP",
+    [BTN_DPAD_DOWN            ] = "BTN_DPAD_DOWN",
+    [BTN_DPAD_LEFT            ] = "BTN_DPAD_LEFT",
+    [BTN_DPAD_RIGHT           ] = "BTN_DPAD_RIGHT",
+    [KEY_ALS_TOGGLE           ] = "ALS_TOGGLE",
+    [KEY_ROTATE_LOCK_TOGGLE   ] = "ROTATE_LOCK_TOGGLE",
+    [KEY_REFRESH_RATE_TOGGLE  ] = "REFRESH_RATE_TOGGLE",
+    [KEY_BUTTONCONFIG         ] = "BUTTONCONFIG",
+    [KEY_TASKMANAGER          ] = "TASKMANAGER",
+    [KEY_JOURNAL              ] = "JOURNAL",
+    [KEY_CONTROLPANEL         ] = "CONTROLPANEL",
+    [KEY_APPSELECT            ] = "APPSELECT",
+    [KEY_SCREENSAVER          ] = "SCREENSAVER",
+    [KEY_VOICECOMMAND         ] = "VOICECOMMAND",
+    [KEY_ASSISTANT            ] = "ASSISTANT",
+    [KEY_KBD_LAYOUT_NEXT      ] = "KBD_LAYOUT_NEXT",
+    [KEY_EMOJI_PICKER         ] = "EMOJI_PICKER",
+    [KEY_DICTATE              ] = "DICTATE",
+    [KEY_BRIGHTNESS_MIN       ] = "BRIGHTNESS_MIN",
+    [KEY_BRIGHTNESS_MAX       ] = "BRIGHTNESS_MAX",
+    [KEY_KBDINPUTASSIST_PREV  ] = "KBDINPUTASSIST_PREV",
+    [KEY_KBDINPUTASSIST_NEXT  ] = "KBDINPUTASSIST_NEXT",
+    [KEY_KBDINPUTASSIST_PREVGROUP] = "KBDINPUTASSIST_PREVGROUP",
+    [KEY_KBDINPUTASSIST_NEXTGROUP] = "KBDINPUTASSIST_NEXTGROUP",
+    [KEY_KBDINPUTASSIST_ACCEPT] = "KBDINPUTASSIST_ACCEPT",
+    [KEY_KBDINPUTASSIST_CANCEL] = "KBDINPUTASSIST_CANCEL",
+    [KEY_RIGHT_UP             ] = "RIGHT_UP",
+    [KEY_RIGHT_DOWN           ] = "RIGHT_DOWN",
+    [KEY_LEFT_UP              ] = "LEFT_UP",
+    [KEY_LEFT_DOWN            ] = "LEFT_DOWN",
+    [KEY_ROOT_MENU            ] = "ROOT_MENU",
+    [KEY_MEDIA_TOP_MENU       ] = "MEDIA_TOP_MENU",
+    [KEY_NUMERIC_11           ] = "NUMERIC_11",
+    [KEY_NUMERIC_12           ] = "NUMERIC_12",
+    [KEY_AUDIO_DESC           ] = "AUDIO_DESC",
+    [KEY_3D_MODE              ] = "3D_MODE",
+    [KEY_NEXT_FAVORITE        ] = "NEXT_FAVORITE",
+    [KEY_STOP_RECORD          ] = "STOP_RECORD",
+    [KEY_PAUSE_RECORD         ] = "PAUSE_RECORD",
+    [KEY_VOD                  ] = "VOD",
+    [KEY_UNMUTE               ] = "UNMUTE",
+    [KEY_FASTREVERSE          ] = "FASTREVERSE",
+    [KEY_SLOWREVERSE          ] = "SLOWREVERSE",
+    [KEY_DATA                 ] = "DATA",
+    [KEY_ONSCREEN_KEYBOARD    ] = "ONSCREEN_KEYBOARD",
+    [KEY_PRIVACY_SCREEN_TOGGLE] = "PRIVACY_SCREEN_TOGGLE",
+    [KEY_SELECTIVE_SCREENSHOT ] = "SELECTIVE_SCREENSHOT",
+    [KEY_NEXT_ELEMENT         ] = "NEXT_ELEMENT",
+    [KEY_PREVIOUS_ELEMENT     ] = "PREVIOUS_ELEMENT",
+    [KEY_AUTOPILOT_ENGAGE_TOGGLE] = "AUTOPILOT_ENGAGE_TOGGLE",
+    [KEY_MARK_WAYPOINT        ] = "MARK_WAYPOINT",
+    [KEY_SOS                  ] = "SOS",
+    [KEY_NAV_CHART            ] = "NAV_CHART",
+    [KEY_FISHING_CHART        ] = "FISHING_CHART",
+    [KEY_SINGLE_RANGE_RADAR   ] = "SINGLE_RANGE_RADAR",
+    [KEY_DUAL_RANGE_RADAR     ] = "DUAL_RANGE_RADAR",
+    [KEY_RADAR_OVERLAY        ] = "RADAR_OVERLAY",
+    [KEY_TRADITIONAL_SONAR    ] = "TRADITIONAL_SONAR",
+    [KEY_CLEARVU_SONAR        ] = "CLEARVU_SONAR",
+    [KEY_SIDEVU_SONAR         ] = "SIDEVU_SONAR",
+    [KEY_NAV_INFO             ] = "NAV_INFO",
+    [KEY_BRIGHTNESS_MENU      ] = "BRIGHTNESS_MENU",
+    [KEY_MACRO1               ] = "MACRO1",
+    [KEY_MACRO2               ] = "MACRO2",
+    [KEY_MACRO3               ] = "MACRO3",
+    [KEY_MACRO4               ] = "MACRO4",
+    [KEY_MACRO5               ] = "MACRO5",
+    [KEY_MACRO6               ] = "MACRO6",
+    [KEY_MACRO7               ] = "MACRO7",
+    [KEY_MACRO8               ] = "MACRO8",
+    [KEY_MACRO9               ] = "MACRO9",
+    [KEY_MACRO10              ] = "MACRO10",
+    [KEY_MACRO11              ] = "MACRO11",
+    [KEY_MACRO12              ] = "MACRO12",
+    [KEY_MACRO13              ] = "MACRO13",
+    [KEY_MACRO14              ] = "MACRO14",
+    [KEY_MACRO15              ] = "MACRO15",
+    [KEY_MACRO16              ] = "MACRO16",
+    [KEY_MACRO17              ] = "MACRO17",
+    [KEY_MACRO18              ] = "MACRO18",
+    [KEY_MACRO19              ] = "MACRO19",
+    [KEY_MACRO20              ] = "MACRO20",
+    [KEY_MACRO21              ] = "MACRO21",
+    [KEY_MACRO22              ] = "MACRO22",
+    [KEY_MACRO23              ] = "MACRO23",
+    [KEY_MACRO24              ] = "MACRO24",
+    [KEY_MACRO25              ] = "MACRO25",
+    [KEY_MACRO26              ] = "MACRO26",
+    [KEY_MACRO27              ] = "MACRO27",
+    [KEY_MACRO28              ] = "MACRO28",
+    [KEY_MACRO29              ] = "MACRO29",
+    [KEY_MACRO30              ] = "MACRO30",
+    [KEY_MACRO_RECORD_START   ] = "MACRO_RECORD_START",
+    [KEY_MACRO_RECORD_STOP    ] = "MACRO_RECORD_STOP",
+    [KEY_MACRO_PRESET_CYCLE   ] = "MACRO_PRESET_CYCLE",
+    [KEY_MACRO_PRESET1        ] = "MACRO_PRESET1",
+    [KEY_MACRO_PRESET2        ] = "MACRO_PRESET2",
+    [KEY_MACRO_PRESET3        ] = "MACRO_PRESET3",
+    [KEY_KBD_LCD_MENU1        ] = "KBD_LCD_MENU1",
+    [KEY_KBD_LCD_MENU2        ] = "KBD_LCD_MENU2",
+    [KEY_KBD_LCD_MENU3        ] = "KBD_LCD_MENU3",
+    [KEY_KBD_LCD_MENU4        ] = "KBD_LCD_MENU4",
+    [KEY_KBD_LCD_MENU5        ] = "KBD_LCD_MENU5",
+    [BTN_TRIGGER_HAPPY        ] = "BTN_TRIGGER_HAPPY",
+    [BTN_TRIGGER_HAPPY1       ] = "BTN_TRIGGER_HAPPY1",
+    [BTN_TRIGGER_HAPPY2       ] = "BTN_TRIGGER_HAPPY2",
+    [BTN_TRIGGER_HAPPY3       ] = "BTN_TRIGGER_HAPPY3",
+    [BTN_TRIGGER_HAPPY4       ] = "BTN_TRIGGER_HAPPY4",
+    [BTN_TRIGGER_HAPPY5       ] = "BTN_TRIGGER_HAPPY5",
+    [BTN_TRIGGER_HAPPY6       ] = "BTN_TRIGGER_HAPPY6",
+    [BTN_TRIGGER_HAPPY7       ] = "BTN_TRIGGER_HAPPY7",
+    [BTN_TRIGGER_HAPPY8       ] = "BTN_TRIGGER_HAPPY8",
+    [BTN_TRIGGER_HAPPY9       ] = "BTN_TRIGGER_HAPPY9",
+    [BTN_TRIGGER_HAPPY10      ] = "BTN_TRIGGER_HAPPY10",
+    [BTN_TRIGGER_HAPPY11      ] = "BTN_TRIGGER_HAPPY11",
+    [BTN_TRIGGER_HAPPY12      ] = "BTN_TRIGGER_HAPPY12",
+    [BTN_TRIGGER_HAPPY13      ] = "BTN_TRIGGER_HAPPY13",
+    [BTN_TRIGGER_HAPPY14      ] = "BTN_TRIGGER_HAPPY14",
+    [BTN_TRIGGER_HAPPY15      ] = "BTN_TRIGGER_HAPPY15",
+    [BTN_TRIGGER_HAPPY16      ] = "BTN_TRIGGER_HAPPY16",
+    [BTN_TRIGGER_HAPPY17      ] = "BTN_TRIGGER_HAPPY17",
+    [BTN_TRIGGER_HAPPY18      ] = "BTN_TRIGGER_HAPPY18",
+    [BTN_TRIGGER_HAPPY19      ] = "BTN_TRIGGER_HAPPY19",
+    [BTN_TRIGGER_HAPPY20      ] = "BTN_TRIGGER_HAPPY20",
+    [BTN_TRIGGER_HAPPY21      ] = "BTN_TRIGGER_HAPPY21",
+    [BTN_TRIGGER_HAPPY22      ] = "BTN_TRIGGER_HAPPY22",
+    [BTN_TRIGGER_HAPPY23      ] = "BTN_TRIGGER_HAPPY23",
+    [BTN_TRIGGER_HAPPY24      ] = "BTN_TRIGGER_HAPPY24",
+    [BTN_TRIGGER_HAPPY25      ] = "BTN_TRIGGER_HAPPY25",
+    [BTN_TRIGGER_HAPPY26      ] = "BTN_TRIGGER_HAPPY26",
+    [BTN_TRIGGER_HAPPY27      ] = "BTN_TRIGGER_HAPPY27",
+    [BTN_TRIGGER_HAPPY28      ] = "BTN_TRIGGER_HAPPY28",
+    [BTN_TRIGGER_HAPPY29      ] = "BTN_TRIGGER_HAPPY29",
+    [BTN_TRIGGER_HAPPY30      ] = "BTN_TRIGGER_HAPPY30",
+    [BTN_TRIGGER_HAPPY31      ] = "BTN_TRIGGER_HAPPY31",
+    [BTN_TRIGGER_HAPPY32      ] = "BTN_TRIGGER_HAPPY32",
+    [BTN_TRIGGER_HAPPY33      ] = "BTN_TRIGGER_HAPPY33",
+    [BTN_TRIGGER_HAPPY34      ] = "BTN_TRIGGER_HAPPY34",
+    [BTN_TRIGGER_HAPPY35      ] = "BTN_TRIGGER_HAPPY35",
+    [BTN_TRIGGER_HAPPY36      ] = "BTN_TRIGGER_HAPPY36",
+    [BTN_TRIGGER_HAPPY37      ] = "BTN_TRIGGER_HAPPY37",
+    [BTN_TRIGGER_HAPPY38      ] = "BTN_TRIGGER_HAPPY38",
+    [BTN_TRIGGER_HAPPY39      ] = "BTN_TRIGGER_HAPPY39",
+    [BTN_TRIGGER_HAPPY40      ] = "BTN_TRIGGER_HAPPY40",
+};
+
+static const char *REL_NAME[REL_CNT] __attribute__((unused)) = {
+    [REL_X                    ] = "X",
+    [REL_Y                    ] = "Y",
+    [REL_Z                    ] = "Z",
+    [REL_RX                   ] = "RX",
+    [REL_RY                   ] = "RY",
+    [REL_RZ                   ] = "RZ",
+    [REL_HWHEEL               ] = "HWHEEL",
+    [REL_DIAL                 ] = "DIAL",
+    [REL_WHEEL                ] = "WHEEL",
+    [REL_MISC                 ] = "MISC",
+    [REL_RESERVED             ] = "RESERVED",
+    [REL_WHEEL_HI_RES         ] = "WHEEL_HI_RES",
+    [REL_HWHEEL_HI_RES        ] = "HWHEEL_HI_RES",
 };
 
-static const char *SW_NAME[SW_CNT] = {
+static const char *ABS_NAME[ABS_CNT] __attribute__((unused)) = {
+    [ABS_X                    ] = "X",
+    [ABS_Y                    ] = "Y",
+    [ABS_Z                    ] = "Z",
+    [ABS_RX                   ] = "RX",
+    [ABS_RY                   ] = "RY",
+    [ABS_RZ                   ] = "RZ",
+    [ABS_THROTTLE             ] = "THROTTLE",
+    [ABS_RUDDER               ] = "RUDDER",
+    [ABS_WHEEL                ] = "WHEEL",
+    [ABS_GAS                  ] = "GAS",
+    [ABS_BRAKE                ] = "BRAKE",
+    [ABS_HAT0X                ] = "HAT0X",
+    [ABS_HAT0Y                ] = "HAT0Y",
+    [ABS_HAT1X                ] = "HAT1X",
+    [ABS_HAT1Y                ] = "HAT1Y",
+    [ABS_HAT2X                ] = "HAT2X",
+    [ABS_HAT2Y                ] = "HAT2Y",
+    [ABS_HAT3X                ] = "HAT3X",
+    [ABS_HAT3Y                ] = "HAT3Y",
+    [ABS_PRESSURE             ] = "PRESSURE",
+    [ABS_DISTANCE             ] = "DISTANCE",
+    [ABS_TILT_X               ] = "TILT_X",
+    [ABS_TILT_Y               ] = "TILT_Y",
+    [ABS_TOOL_WIDTH           ] = "TOOL_WIDTH",
+    [ABS_VOLUME               ] = "VOLUME",
+    [ABS_PROFILE              ] = "PROFILE",
+    [ABS_MISC                 ] = "MISC",
+    [ABS_RESERVED             ] = "RESERVED",
+    [ABS_MT_SLOT              ] = "MT_SLOT",
+    [ABS_MT_TOUCH_MAJOR       ] = "MT_TOUCH_MAJOR",
+    [ABS_MT_TOUCH_MINOR       ] = "MT_TOUCH_MINOR",
+    [ABS_MT_WIDTH_MAJOR       ] = "MT_WIDTH_MAJOR",
+    [ABS_MT_WIDTH_MINOR       ] = "MT_WIDTH_MINOR",
+    [ABS_MT_ORIENTATION       ] = "MT_ORIENTATION",
+    [ABS_MT_POSITION_X        ] = "MT_POSITION_X",
+    [ABS_MT_POSITION_Y        ] = "MT_POSITION_Y",
+    [ABS_MT_TOOL_TYPE         ] = "MT_TOOL_TYPE",
+    [ABS_MT_BLOB_ID           ] = "MT_BLOB_ID",
+    [ABS_MT_TRACKING_ID       ] = "MT_TRACKING_ID",
+    [ABS_MT_PRESSURE          ] = "MT_PRESSURE",
+    [ABS_MT_DISTANCE          ] = "MT_DISTANCE",
+    [ABS_MT_TOOL_X            ] = "MT_TOOL_X",
+    [ABS_MT_TOOL_Y            ] = "MT_TOOL_Y",
+};
+
+static const char *SW_NAME[SW_CNT] __attribute__((unused)) = {
     [SW_LID                   ] = "LID",
     [SW_TABLET_MODE           ] = "TABLET_MODE",
     [SW_HEADPHONE_INSERT      ] = "HEADPHONE_INSERT",
@@ -460,4 +713,730 @@ static const char *SW_NAME[SW_CNT] = {
     [SW_LINEOUT_INSERT        ] = "LINEOUT_INSERT",
     [SW_JACK_PHYSICAL_INSERT  ] = "JACK_PHYSICAL_INSERT",
     [SW_VIDEOOUT_INSERT       ] = "VIDEOOUT_INSERT",
+    [SW_CAMERA_LENS_COVER     ] = "CAMERA_LENS_COVER",
+    [SW_KEYPAD_SLIDE          ] = "KEYPAD_SLIDE",
+    [SW_FRONT_PROXIMITY       ] = "FRONT_PROXIMITY",
+    [SW_ROTATE_LOCK           ] = "ROTATE_LOCK",
+    [SW_LINEIN_INSERT         ] = "LINEIN_INSERT",
+    [SW_MUTE_DEVICE           ] = "MUTE_DEVICE",
+    [SW_PEN_INSERTED          ] = "PEN_INSERTED",
+    [SW_MACHINE_COVER         ] = "MACHINE_COVER",
+};
+
+static const event_code_t KEY_CODE[] = {
+    { "0",                         KEY_0                     },
+    { "1",                         KEY_1                     },
+    { "102ND",                     KEY_102ND                 },
+    { "10CHANNELSDOWN",            KEY_10CHANNELSDOWN        },
+    { "10CHANNELSUP",              KEY_10CHANNELSUP          },
+    { "2",                         KEY_2                     },
+    { "3",                         KEY_3                     },
+    { "3D_MODE",                   KEY_3D_MODE               },
+    { "4",                         KEY_4                     },
+    { "5",                         KEY_5                     },
+    { "6",                         KEY_6                     },
+    { "7",                         KEY_7                     },
+    { "8",                         KEY_8                     },
+    { "9",                         KEY_9                     },
+    { "A",                         KEY_A                     },
+    { "AB",                        KEY_AB                    },
+    { "ADDRESSBOOK",               KEY_ADDRESSBOOK           },
+    { "AGAIN",                     KEY_AGAIN                 },
+    { "ALL_APPLICATIONS",          KEY_ALL_APPLICATIONS      },
+    { "ALS_TOGGLE",                KEY_ALS_TOGGLE            },
+    { "ALTERASE",                  KEY_ALTERASE              },
+    { "ANGLE",                     KEY_ANGLE                 },
+    { "APOSTROPHE",                KEY_APOSTROPHE            },
+    { "APPSELECT",                 KEY_APPSELECT             },
+    { "ARCHIVE",                   KEY_ARCHIVE               },
+    { "ASPECT_RATIO",              KEY_ASPECT_RATIO          },
+    { "ASSISTANT",                 KEY_ASSISTANT             },
+    { "ATTENDANT_OFF",             KEY_ATTENDANT_OFF         },
+    { "ATTENDANT_ON",              KEY_ATTENDANT_ON          },
+    { "ATTENDANT_TOGGLE",          KEY_ATTENDANT_TOGGLE      },
+    { "AUDIO",                     KEY_AUDIO                 },
+    { "AUDIO_DESC",                KEY_AUDIO_DESC            },
+    { "AUTOPILOT_ENGAGE_TOGGLE",   KEY_AUTOPILOT_ENGAGE_TOGGLE },
+    { "AUX",                       KEY_AUX                   },
+    { "B",                         KEY_B                     },
+    { "BACK",                      KEY_BACK                  },
+    { "BACKSLASH",                 KEY_BACKSLASH             },
+    { "BACKSPACE",                 KEY_BACKSPACE             },
+    { "BASSBOOST",                 KEY_BASSBOOST             },
+    { "BATTERY",                   KEY_BATTERY               },
+    { "BLUE",                      KEY_BLUE                  },
+    { "BLUETOOTH",                 KEY_BLUETOOTH             },
+    { "BOOKMARKS",                 KEY_BOOKMARKS             },
+    { "BREAK",                     KEY_BREAK                 },
+    { "BRIGHTNESS_AUTO",           KEY_BRIGHTNESS_AUTO       },
+    { "BRIGHTNESS_CYCLE",          KEY_BRIGHTNESS_CYCLE      },
+    { "BRIGHTNESS_MAX",            KEY_BRIGHTNESS_MAX        },
+    { "BRIGHTNESS_MENU",           KEY_BRIGHTNESS_MENU       },
+    { "BRIGHTNESS_MIN",            KEY_BRIGHTNESS_MIN        },
+    { "BRIGHTNESS_TOGGLE",         KEY_BRIGHTNESS_TOGGLE     },
+    { "BRIGHTNESS_ZERO",           KEY_BRIGHTNESS_ZERO       },
+    { "BRIGHTNESSDOWN",            KEY_BRIGHTNESSDOWN        },
+    { "BRIGHTNESSUP",              KEY_BRIGHTNESSUP          },
+    { "BRL_DOT1",                  KEY_BRL_DOT1              },
+    { "BRL_DOT10",                 KEY_BRL_DOT10             },
+    { "BRL_DOT2",                  KEY_BRL_DOT2              },
+    { "BRL_DOT3",                  KEY_BRL_DOT3              },
+    { "BRL_DOT4",                  KEY_BRL_DOT4              },
+    { "BRL_DOT5",                  KEY_BRL_DOT5              },
+    { "BRL_DOT6",                  KEY_BRL_DOT6              },
+    { "BRL_DOT7",                  KEY_BRL_DOT7              },
+    { "BRL_DOT8",                  KEY_BRL_DOT8              },
+    { "BRL_DOT9",                  KEY_BRL_DOT9              },
+    { "BTN_0",                     BTN_0                     },
+    { "BTN_1",                     BTN_1                     },
+    { "BTN_2",                     BTN_2                     },
+    { "BTN_3",                     BTN_3                     },
+    { "BTN_4",                     BTN_4                     },
+    { "BTN_5",                     BTN_5                     },
+    { "BTN_6",                     BTN_6                     },
+    { "BTN_7",                     BTN_7                     },
+    { "BTN_8",                     BTN_8                     },
+    { "BTN_9",                     BTN_9                     },
+    { "BTN_A",                     BTN_A                     },
+    { "BTN_B",                     BTN_B                     },
+    { "BTN_BACK",                  BTN_BACK                  },
+    { "BTN_BASE",                  BTN_BASE                  },
+    { "BTN_BASE2",                 BTN_BASE2                 },
+    { "BTN_BASE3",                 BTN_BASE3                 },
+    { "BTN_BASE4",                 BTN_BASE4                 },
+    { "BTN_BASE5",                 BTN_BASE5                 },
+    { "BTN_BASE6",                 BTN_BASE6                 },
+    { "BTN_C",                     BTN_C                     },
+    { "BTN_DEAD",                  BTN_DEAD                  },
+    { "BTN_DIGI",                  BTN_DIGI                  },
+    { "BTN_DPAD_DOWN",             BTN_DPAD_DOWN             },
+    { "BTN_DPAD_LEFT",             BTN_DPAD_LEFT             },
+    { "BTN_DPAD_RIGHT",            BTN_DPAD_RIGHT            },
+    { "BTN_DPAD_UP",               BTN_DPAD_UP               },
+    { "BTN_EAST",                  BTN_EAST                  },
+    { "BTN_EXTRA",                 BTN_EXTRA                 },
+    { "BTN_FORWARD",               BTN_FORWARD               },
+    { "BTN_GAMEPAD",               BTN_GAMEPAD               },
+    { "BTN_GEAR_DOWN",             BTN_GEAR_DOWN             },
+    { "BTN_GEAR_UP",               BTN_GEAR_UP               },
+    { "BTN_JOYSTICK",              BTN_JOYSTICK              },
+    { "BTN_LEFT",                  BTN_LEFT                  },
+    { "BTN_MIDDLE",                BTN_MIDDLE                },
+    { "BTN_MISC",                  BTN_MISC                  },
+    { "BTN_MODE",                  BTN_MODE                  },
+    { "BTN_MOUSE",                 BTN_MOUSE                 },
+    { "BTN_NORTH",                 BTN_NORTH                 },
+    { "BTN_PINKIE",                BTN_PINKIE                },
+    { "BTN_RIGHT",                 BTN_RIGHT                 },
+    { "BTN_SELECT",                BTN_SELECT                },
+    { "BTN_SIDE",                  BTN_SIDE                  },
+    { "BTN_SOUTH",                 BTN_SOUTH                 },
+    { "BTN_START",                 BTN_START                 },
+    { "BTN_STYLUS",                BTN_STYLUS                },
+    { "BTN_STYLUS2",               BTN_STYLUS2               },
+    { "BTN_STYLUS3",               BTN_STYLUS3               },
+    { "BTN_TASK",                  BTN_TASK                  },
+    { "BTN_THUMB",                 BTN_THUMB                 },
+    { "BTN_THUMB2",                BTN_THUMB2                },
+    { "BTN_THUMBL",                BTN_THUMBL                },
+    { "BTN_THUMBR",                BTN_THUMBR                },
+    { "BTN_TL",                    BTN_TL                    },
+    { "BTN_TL2",                   BTN_TL2                   },
+    { "BTN_TOOL_AIRBRUSH",         BTN_TOOL_AIRBRUSH         },
+    { "BTN_TOOL_BRUSH",            BTN_TOOL_BRUSH            },
+    { "BTN_TOOL_DOUBLETAP",        BTN_TOOL_DOUBLETAP        },
+    { "BTN_TOOL_FINGER",           BTN_TOOL_FINGER           },
+    { "BTN_TOOL_LENS",             BTN_TOOL_LENS             },
+    { "BTN_TOOL_MOUSE",            BTN_TOOL_MOUSE            },
+    { "BTN_TOOL_PEN",              BTN_TOOL_PEN              },
+    { "BTN_TOOL_PENCIL",           BTN_TOOL_PENCIL           },
+    { "BTN_TOOL_QUADTAP",          BTN_TOOL_QUADTAP          },
+    { "BTN_TOOL_QUINTTAP",         BTN_TOOL_QUINTTAP         },
+    { "BTN_TOOL_RUBBER",           BTN_TOOL_RUBBER           },
+    { "BTN_TOOL_TRIPLETAP",        BTN_TOOL_TRIPLETAP        },
+    { "BTN_TOP",                   BTN_TOP                   },
+    { "BTN_TOP2",                  BTN_TOP2                  },
+    { "BTN_TOUCH",                 BTN_TOUCH                 },
+    { "BTN_TR",                    BTN_TR                    },
+    { "BTN_TR2",                   BTN_TR2                   },
+    { "BTN_TRIGGER",               BTN_TRIGGER               },
+    { "BTN_TRIGGER_HAPPY",         BTN_TRIGGER_HAPPY         },
+    { "BTN_TRIGGER_HAPPY1",        BTN_TRIGGER_HAPPY1        },
+    { "BTN_TRIGGER_HAPPY10",       BTN_TRIGGER_HAPPY10       },
+    { "BTN_TRIGGER_HAPPY11",       BTN_TRIGGER_HAPPY11       },
+    { "BTN_TRIGGER_HAPPY12",       BTN_TRIGGER_HAPPY12       },
+    { "BTN_TRIGGER_HAPPY13",       BTN_TRIGGER_HAPPY13       },
+    { "BTN_TRIGGER_HAPPY14",       BTN_TRIGGER_HAPPY14       },
+    { "BTN_TRIGGER_HAPPY15",       BTN_TRIGGER_HAPPY15       },
+    { "BTN_TRIGGER_HAPPY16",       BTN_TRIGGER_HAPPY16       },
+    { "BTN_TRIGGER_HAPPY17",       BTN_TRIGGER_HAPPY17       },
+    { "BTN_TRIGGER_HAPPY18",       BTN_TRIGGER_HAPPY18       },
+    { "BTN_TRIGGER_HAPPY19",       BTN_TRIGGER_HAPPY19       },
+    { "BTN_TRIGGER_HAPPY2",        BTN_TRIGGER_HAPPY2        },
+    { "BTN_TRIGGER_HAPPY20",       BTN_TRIGGER_HAPPY20       },
+    { "BTN_TRIGGER_HAPPY21",       BTN_TRIGGER_HAPPY21       },
+    { "BTN_TRIGGER_HAPPY22",       BTN_TRIGGER_HAPPY22       },
+    { "BTN_TRIGGER_HAPPY23",       BTN_TRIGGER_HAPPY23       },
+    { "BTN_TRIGGER_HAPPY24",       BTN_TRIGGER_HAPPY24       },
+    { "BTN_TRIGGER_HAPPY25",       BTN_TRIGGER_HAPPY25       },
+    { "BTN_TRIGGER_HAPPY26",       BTN_TRIGGER_HAPPY26       },
+    { "BTN_TRIGGER_HAPPY27",       BTN_TRIGGER_HAPPY27       },
+    { "BTN_TRIGGER_HAPPY28",       BTN_TRIGGER_HAPPY28       },
+    { "BTN_TRIGGER_HAPPY29",       BTN_TRIGGER_HAPPY29       },
+    { "BTN_TRIGGER_HAPPY3",        BTN_TRIGGER_HAPPY3        },
+    { "BTN_TRIGGER_HAPPY30",       BTN_TRIGGER_HAPPY30       },
+    { "BTN_TRIGGER_HAPPY31",       BTN_TRIGGER_HAPPY31       },
+    { "BTN_TRIGGER_HAPPY32",       BTN_TRIGGER_HAPPY32       },
+    { "BTN_TRIGGER_HAPPY33",       BTN_TRIGGER_HAPPY33       },
+    { "BTN_TRIGGER_HAPPY34",       BTN_TRIGGER_HAPPY34       },
+    { "BTN_TRIGGER_HAPPY35",       BTN_TRIGGER_HAPPY35       },
+    { "BTN_TRIGGER_HAPPY36",       BTN_TRIGGER_HAPPY36       },
+    { "BTN_TRIGGER_HAPPY37",       BTN_TRIGGER_HAPPY37       },
+    { "BTN_TRIGGER_HAPPY38",       BTN_TRIGGER_HAPPY38       },
+    { "BTN_TRIGGER_HAPPY39",       BTN_TRIGGER_HAPPY39       },
+    { "BTN_TRIGGER_HAPPY4",        BTN_TRIGGER_HAPPY4        },
+    { "BTN_TRIGGER_HAPPY40",       BTN_TRIGGER_HAPPY40       },
+    { "BTN_TRIGGER_HAPPY5",        BTN_TRIGGER_HAPPY5        },
+    { "BTN_TRIGGER_HAPPY6",        BTN_TRIGGER_HAPPY6        },
+    { "BTN_TRIGGER_HAPPY7",        BTN_TRIGGER_HAPPY7        },
+    { "BTN_TRIGGER_HAPPY8",        BTN_TRIGGER_HAPPY8        },
+    { "BTN_TRIGGER_HAPPY9",        BTN_TRIGGER_HAPPY9        },
+    { "BTN_WEST",                  BTN_WEST                  },
+    { "BTN_WHEEL",                 BTN_WHEEL                 },
+    { "BTN_X",                     BTN_X                     },
+    { "BTN_Y",                     BTN_Y                     },
+    { "BTN_Z",                     BTN_Z                     },
+    { "BUTTONCONFIG",              KEY_BUTTONCONFIG          },
+    { "C",                         KEY_C                     },
+    { "CALC",                      KEY_CALC                  },
+    { "CALENDAR",                  KEY_CALENDAR              },
+    { "CAMERA",                    KEY_CAMERA                },
+    { "CAMERA_DOWN",               KEY_CAMERA_DOWN           },
+    { "CAMERA_FOCUS",              KEY_CAMERA_FOCUS          },
+    { "CAMERA_LEFT",               KEY_CAMERA_LEFT           },
+    { "CAMERA_RIGHT",              KEY_CAMERA_RIGHT          },
+    { "CAMERA_UP",                 KEY_CAMERA_UP             },
+    { "CAMERA_ZOOMIN",             KEY_CAMERA_ZOOMIN         },
+    { "CAMERA_ZOOMOUT",            KEY_CAMERA_ZOOMOUT        },
+    { "CANCEL",                    KEY_CANCEL                },
+    { "CAPSLOCK",                  KEY_CAPSLOCK              },
+    { "CD",                        KEY_CD                    },
+    { "CHANNEL",                   KEY_CHANNEL               },
+    { "CHANNELDOWN",               KEY_CHANNELDOWN           },
+    { "CHANNELUP",                 KEY_CHANNELUP             },
+    { "CHAT",                      KEY_CHAT                  },
+    { "CLEAR",                     KEY_CLEAR                 },
+    { "CLEARVU_SONAR",             KEY_CLEARVU_SONAR         },
+    { "CLOSE",                     KEY_CLOSE                 },
+    { "CLOSECD",                   KEY_CLOSECD               },
+    { "COFFEE",                    KEY_COFFEE                },
+    { "COMMA",                     KEY_COMMA                 },
+    { "COMPOSE",                   KEY_COMPOSE               },
+    { "COMPUTER",                  KEY_COMPUTER              },
+    { "CONFIG",                    KEY_CONFIG                },
+    { "CONNECT",                   KEY_CONNECT               },
+    { "CONTEXT_MENU",              KEY_CONTEXT_MENU          },
+    { "CONTROLPANEL",              KEY_CONTROLPANEL          },
+    { "COPY",                      KEY_COPY                  },
+    { "CUT",                       KEY_CUT                   },
+    { "CYCLEWINDOWS",              KEY_CYCLEWINDOWS          },
+    { "D",                         KEY_D                     },
+    { "DASHBOARD",                 KEY_DASHBOARD             },
+    { "DATA",                      KEY_DATA                  },
+    { "DATABASE",                  KEY_DATABASE              },
+    { "DEL_EOL",                   KEY_DEL_EOL               },
+    { "DEL_EOS",                   KEY_DEL_EOS               },
+    { "DEL_LINE",                  KEY_DEL_LINE              },
+    { "DELETE",                    KEY_DELETE                },
+    { "DELETEFILE",                KEY_DELETEFILE            },
+    { "DICTATE",                   KEY_DICTATE               },
+    { "DIGITS",                    KEY_DIGITS                },
+    { "DIRECTION",                 KEY_DIRECTION             },
+    { "DIRECTORY",                 KEY_DIRECTORY             },
+    { "DISPLAY_OFF",               KEY_DISPLAY_OFF           },
+    { "DISPLAYTOGGLE",             KEY_DISPLAYTOGGLE         },
+    { "DOCUMENTS",                 KEY_DOCUMENTS             },
+    { "DOLLAR",                    KEY_DOLLAR                },
+    { "DOT",                       KEY_DOT                   },
+    { "DOWN",                      KEY_DOWN                  },
+    { "DUAL_RANGE_RADAR",          KEY_DUAL_RANGE_RADAR      },
+    { "DVD",                       KEY_DVD                   },
+    { "E",                         KEY_E                     },
+    { "EDIT",                      KEY_EDIT                  },
+    { "EDITOR",                    KEY_EDITOR                },
+    { "EJECTCD",                   KEY_EJECTCD               },
+    { "EJECTCLOSECD",              KEY_EJECTCLOSECD          },
+    { "EMAIL",                     KEY_EMAIL                 },
+    { "EMOJI_PICKER",              KEY_EMOJI_PICKER          },
+    { "END",                       KEY_END                   },
+    { "ENTER",                     KEY_ENTER                 },
+    { "EPG",                       KEY_EPG                   },
+    { "EQUAL",                     KEY_EQUAL                 },
+    { "ESC",                       KEY_ESC                   },
+    { "EURO",                      KEY_EURO                  },
+    { "EXIT",                      KEY_EXIT                  },
+    { "F",                         KEY_F                     },
+    { "F1",                        KEY_F1                    },
+    { "F10",                       KEY_F10                   },
+    { "F11",                       KEY_F11                   },
+    { "F12",                       KEY_F12                   },
+    { "F13",                       KEY_F13                   },
+    { "F14",                       KEY_F14                   },
+    { "F15",                       KEY_F15                   },
+    { "F16",                       KEY_F16                   },
+    { "F17",                       KEY_F17                   },
+    { "F18",                       KEY_F18                   },
+    { "F19",                       KEY_F19                   },
+    { "F2",                        KEY_F2                    },
+    { "F20",                       KEY_F20                   },
+    { "F21",                       KEY_F21                   },
+    { "F22",                       KEY_F22                   },
+    { "F23",                       KEY_F23                   },
+    { "F24",                       KEY_F24                   },
+    { "F3",                        KEY_F3                    },
+    { "F4",                        KEY_F4                    },
+    { "F5",                        KEY_F5                    },
+    { "F6",                        KEY_F6                    },
+    { "F7",                        KEY_F7                    },
+    { "F8",                        KEY_F8                    },
+    { "F9",                        KEY_F9                    },
+    { "FASTFORWARD",               KEY_FASTFORWARD           },
+    { "FASTREVERSE",               KEY_FASTREVERSE           },
+    { "FAVORITES",                 KEY_FAVORITES             },
+    { "FILE",                      KEY_FILE                  },
+    { "FINANCE",                   KEY_FINANCE               },
+    { "FIND",                      KEY_FIND                  },
+    { "FIRST",                     KEY_FIRST                 },
+    { "FISHING_CHART",             KEY_FISHING_CHART         },
+    { "FN",                        KEY_FN                    },
+    { "FN_1",                      KEY_FN_1                  },
+    { "FN_2",                      KEY_FN_2                  },
+    { "FN_B",                      KEY_FN_B                  },
+    { "FN_D",                      KEY_FN_D                  },
+    { "FN_E",                      KEY_FN_E                  },
+    { "FN_ESC",                    KEY_FN_ESC                },
+    { "FN_F",                      KEY_FN_F                  },
+    { "FN_F1",                     KEY_FN_F1                 },
+    { "FN_F10",                    KEY_FN_F10                },
+    { "FN_F11",                    KEY_FN_F11                },
+    { "FN_F12",                    KEY_FN_F12                },
+    { "FN_F2",                     KEY_FN_F2                 },
+    { "FN_F3",                     KEY_FN_F3                 },
+    { "FN_F4",                     KEY_FN_F4                 },
+    { "FN_F5",                     KEY_FN_F5                 },
+    { "FN_F6",                     KEY_FN_F6                 },
+    { "FN_F7",                     KEY_FN_F7                 },
+    { "FN_F8",                     KEY_FN_F8                 },
+    { "FN_F9",                     KEY_FN_F9                 },
+    { "FN_RIGHT_SHIFT",            KEY_FN_RIGHT_SHIFT        },
+    { "FN_S",                      KEY_FN_S                  },
+    { "FORWARD",                   KEY_FORWARD               },
+    { "FORWARDMAIL",               KEY_FORWARDMAIL           },
+    { "FRAMEBACK",                 KEY_FRAMEBACK             },
+    { "FRAMEFORWARD",              KEY_FRAMEFORWARD          },
+    { "FRONT",                     KEY_FRONT                 },
+    { "FULL_SCREEN",               KEY_FULL_SCREEN           },
+    { "G",                         KEY_G                     },
+    { "GAMES",                     KEY_GAMES                 },
+    { "GOTO",                      KEY_GOTO                  },
+    { "GRAPHICSEDITOR",            KEY_GRAPHICSEDITOR        },
+    { "GRAVE",                     KEY_GRAVE                 },
+    { "GREEN",                     KEY_GREEN                 },
+    { "H",                         KEY_H                     },
+    { "HANGEUL",                   KEY_HANGEUL               },
+    { "HANGUEL",                   KEY_HANGUEL               },
+    { "HANGUP_PHONE",              KEY_HANGUP_PHONE          },
+    { "HANJA",                     KEY_HANJA                 },
+    { "HELP",                      KEY_HELP                  },
+    { "HENKAN",                    KEY_HENKAN                },
+    { "HIRAGANA",                  KEY_HIRAGANA              },
+    { "HOME",                      KEY_HOME                  },
+    { "HOMEPAGE",                  KEY_HOMEPAGE              },
+    { "HP",                        KEY_HP                    },
+    { "I",                         KEY_I                     },
+    { "IMAGES",                    KEY_IMAGES                },
+    { "INFO",                      KEY_INFO                  },
+    { "INS_LINE",                  KEY_INS_LINE              },
+    { "INSERT",                    KEY_INSERT                },
+    { "ISO",                       KEY_ISO                   },
+    { "J",                         KEY_J                     },
+    { "JOURNAL",                   KEY_JOURNAL               },
+    { "K",                         KEY_K                     },
+    { "KATAKANA",                  KEY_KATAKANA              },
+    { "KATAKANAHIRAGANA",          KEY_KATAKANAHIRAGANA      },
+    { "KBD_LAYOUT_NEXT",           KEY_KBD_LAYOUT_NEXT       },
+    { "KBD_LCD_MENU1",             KEY_KBD_LCD_MENU1         },
+    { "KBD_LCD_MENU2",             KEY_KBD_LCD_MENU2         },
+    { "KBD_LCD_MENU3",             KEY_KBD_LCD_MENU3         },
+    { "KBD_LCD_MENU4",             KEY_KBD_LCD_MENU4         },
+    { "KBD_LCD_MENU5",             KEY_KBD_LCD_MENU5         },
+    { "KBDILLUMDOWN",              KEY_KBDILLUMDOWN          },
+    { "KBDILLUMTOGGLE",            KEY_KBDILLUMTOGGLE        },
+    { "KBDILLUMUP",                KEY_KBDILLUMUP            },
+    { "KBDINPUTASSIST_ACCEPT",     KEY_KBDINPUTASSIST_ACCEPT },
+    { "KBDINPUTASSIST_CANCEL",     KEY_KBDINPUTASSIST_CANCEL },
+    { "KBDINPUTASSIST_NEXT",       KEY_KBDINPUTASSIST_NEXT   },
+    { "KBDINPUTASSIST_NEXTGROUP",  KEY_KBDINPUTASSIST_NEXTGROUP },
+    { "KBDINPUTASSIST_PREV",       KEY_KBDINPUTASSIST_PREV   },
+    { "KBDINPUTASSIST_PREVGROUP",  KEY_KBDINPUTASSIST_PREVGROUP },
+    { "KEYBOARD",                  KEY_KEYBOARD              },
+    { "KP0",                       KEY_KP0                   },
+    { "KP1",                       KEY_KP1                   },
+    { "KP2",                       KEY_KP2                   },
+    { "KP3",                       KEY_KP3                   },
+    { "KP4",                       KEY_KP4                   },
+    { "KP5",                       KEY_KP5                   },
+    { "KP6",                       KEY_KP6                   },
+    { "KP7",                       KEY_KP7                   },
+    { "KP8",                       KEY_KP8                   },
+    { "KP9",                       KEY_KP9                   },
+    { "KPASTERISK",                KEY_KPASTERISK            },
+    { "KPCOMMA",                   KEY_KPCOMMA               },
+    { "KPDOT",                     KEY_KPDOT                 },
+    { "KPENTER",                   KEY_KPENTER               },
+    { "KPEQUAL",                   KEY_KPEQUAL               },
+    { "KPJPCOMMA",                 KEY_KPJPCOMMA             },
+    { "KPLEFTPAREN",               KEY_KPLEFTPAREN           },
+    { "KPMINUS",                   KEY_KPMINUS               },
+    { "KPPLUS",                    KEY_KPPLUS                },
+    { "KPPLUSMINUS",               KEY_KPPLUSMINUS           },
+    { "KPRIGHTPAREN",              KEY_KPRIGHTPAREN          },
+    { "KPSLASH",                   KEY_KPSLASH               },
+    { "L",                         KEY_L                     },
+    { "LANGUAGE",                  KEY_LANGUAGE              },
+    { "LAST",                      KEY_LAST                  },
+    { "LEFT",                      KEY_LEFT                  },
+    { "LEFT_DOWN",                 KEY_LEFT_DOWN             },
+    { "LEFT_UP",                   KEY_LEFT_UP               },
+    { "LEFTALT",                   KEY_LEFTALT               },
+    { "LEFTBRACE",                 KEY_LEFTBRACE             },
+    { "LEFTCTRL",                  KEY_LEFTCTRL              },
+    { "LEFTMETA",                  KEY_LEFTMETA              },
+    { "LEFTSHIFT",                 KEY_LEFTSHIFT             },
+    { "LIGHTS_TOGGLE",             KEY_LIGHTS_TOGGLE         },
+    { "LINEFEED",                  KEY_LINEFEED              },
+    { "LINK_PHONE",                KEY_LINK_PHONE            },
+    { "LIST",                      KEY_LIST                  },
+    { "LOGOFF",                    KEY_LOGOFF                },
+    { "M",                         KEY_M                     },
+    { "MACRO",                     KEY_MACRO                 },
+    { "MACRO1",                    KEY_MACRO1                },
+    { "MACRO10",                   KEY_MACRO10               },
+    { "MACRO11",                   KEY_MACRO11               },
+    { "MACRO12",                   KEY_MACRO12               },
+    { "MACRO13",                   KEY_MACRO13               },
+    { "MACRO14",                   KEY_MACRO14               },
+    { "MACRO15",                   KEY_MACRO15               },
+    { "MACRO16",                   KEY_MACRO16               },
+    { "MACRO17",                   KEY_MACRO17               },
+    { "MACRO18",                   KEY_MACRO18               },
+    { "MACRO19",                   KEY_MACRO19               },
+    { "MACRO2",                    KEY_MACRO2                },
+    { "MACRO20",                   KEY_MACRO20               },
+    { "MACRO21",                   KEY_MACRO21               },
+    { "MACRO22",                   KEY_MACRO22               },
+    { "MACRO23",                   KEY_MACRO23               },
+    { "MACRO24",                   KEY_MACRO24               },
+    { "MACRO25",                   KEY_MACRO25               },
+    { "MACRO26",                   KEY_MACRO26               },
+    { "MACRO27",                   KEY_MACRO27               },
+    { "MACRO28",                   KEY_MACRO28               },
+    { "MACRO29",                   KEY_MACRO29               },
+    { "MACRO3",                    KEY_MACRO3                },
+    { "MACRO30",                   KEY_MACRO30               },
+    { "MACRO4",                    KEY_MACRO4                },
+    { "MACRO5",                    KEY_MACRO5                },
+    { "MACRO6",                    KEY_MACRO6                },
+    { "MACRO7",                    KEY_MACRO7                },
+    { "MACRO8",                    KEY_MACRO8                },
+    { "MACRO9",                    KEY_MACRO9                },
+    { "MACRO_PRESET1",             KEY_MACRO_PRESET1         },
+    { "MACRO_PRESET2",             KEY_MACRO_PRESET2         },
+    { "MACRO_PRESET3",             KEY_MACRO_PRESET3         },
+    { "MACRO_PRESET_CYCLE",        KEY_MACRO_PRESET_CYCLE    },
+    { "MACRO_RECORD_START",        KEY_MACRO_RECORD_START    },
+    { "MACRO_RECORD_STOP",         KEY_MACRO_RECORD_STOP     },
+    { "MAIL",                      KEY_MAIL                  },
+    { "MARK_WAYPOINT",             KEY_MARK_WAYPOINT         },
+    { "MEDIA",                     KEY_MEDIA                 },
+    { "MEDIA_REPEAT",              KEY_MEDIA_REPEAT          },
+    { "MEDIA_TOP_MENU",            KEY_MEDIA_TOP_MENU        },
+    { "MEMO",                      KEY_MEMO                  },
+    { "MENU",                      KEY_MENU                  },
+    { "MESSENGER",                 KEY_MESSENGER             },
+    { "MHP",                       KEY_MHP                   },
+    { "MICMUTE",                   KEY_MICMUTE               },
+    { "MINUS",                     KEY_MINUS                 },
+    { "MODE",                      KEY_MODE                  },
+    { "MOVE",                      KEY_MOVE                  },
+    { "MP3",                       KEY_MP3                   },
+    { "MSDOS",                     KEY_MSDOS                 },
+    { "MUHENKAN",                  KEY_MUHENKAN              },
+    { "MUTE",                      KEY_MUTE                  },
+    { "N",                         KEY_N                     },
+    { "NAV_CHART",                 KEY_NAV_CHART             },
+    { "NAV_INFO",                  KEY_NAV_INFO              },
+    { "NEW",                       KEY_NEW                   },
+    { "NEWS",                      KEY_NEWS                  },
+    { "NEXT",                      KEY_NEXT                  },
+    { "NEXT_ELEMENT",              KEY_NEXT_ELEMENT          },
+    { "NEXT_FAVORITE",             KEY_NEXT_FAVORITE         },
+    { "NEXTSONG",                  KEY_NEXTSONG              },
+    { "NOTIFICATION_CENTER",       KEY_NOTIFICATION_CENTER   },
+    { "NUMERIC_0",                 KEY_NUMERIC_0             },
+    { "NUMERIC_1",                 KEY_NUMERIC_1             },
+    { "NUMERIC_11",                KEY_NUMERIC_11            },
+    { "NUMERIC_12",                KEY_NUMERIC_12            },
+    { "NUMERIC_2",                 KEY_NUMERIC_2             },
+    { "NUMERIC_3",                 KEY_NUMERIC_3             },
+    { "NUMERIC_4",                 KEY_NUMERIC_4             },
+    { "NUMERIC_5",                 KEY_NUMERIC_5             },
+    { "NUMERIC_6",                 KEY_NUMERIC_6             },
+    { "NUMERIC_7",                 KEY_NUMERIC_7             },
+    { "NUMERIC_8",                 KEY_NUMERIC_8             },
+    { "NUMERIC_9",                 KEY_NUMERIC_9             },
+    { "NUMERIC_A",                 KEY_NUMERIC_A             },
+    { "NUMERIC_B",                 KEY_NUMERIC_B             },
+    { "NUMERIC_C",                 KEY_NUMERIC_C             },
+    { "NUMERIC_D",                 KEY_NUMERIC_D             },
+    { "NUMERIC_POUND",             KEY_NUMERIC_POUND         },
+    { "NUMERIC_STAR",              KEY_NUMERIC_STAR          },
+    { "NUMLOCK",                   KEY_NUMLOCK               },
+    { "O",                         KEY_O                     },
+    { "OK",                        KEY_OK                    },
+    { "ONSCREEN_KEYBOARD",         KEY_ONSCREEN_KEYBOARD     },
+    { "OPEN",                      KEY_OPEN                  },
+    { "OPTION",                    KEY_OPTION                },
+    { "P",                         KEY_P                     },
+    { "PAGEDOWN",                  KEY_PAGEDOWN              },
+    { "PAGEUP",                    KEY_PAGEUP                },
+    { "PASTE",                     KEY_PASTE                 },
+    { "PAUSE",                     KEY_PAUSE                 },
+    { "PAUSE_RECORD",              KEY_PAUSE_RECORD          },
+    { "PAUSECD",                   KEY_PAUSECD               },
+    { "PC",                        KEY_PC                    },
+    { "PHONE",                     KEY_PHONE                 },
+    { "PICKUP_PHONE",              KEY_PICKUP_PHONE          },
+    { "PLAY",                      KEY_PLAY                  },
+    { "PLAYCD",                    KEY_PLAYCD                },
+    { "PLAYER",                    KEY_PLAYER                },
+    { "PLAYPAUSE",                 KEY_PLAYPAUSE             },
+    { "POWER",                     KEY_POWER                 },
+    { "POWER2",                    KEY_POWER2                },
+    { "PRESENTATION",              KEY_PRESENTATION          },
+    { "PREVIOUS",                  KEY_PREVIOUS              },
+    { "PREVIOUS_ELEMENT",          KEY_PREVIOUS_ELEMENT      },
+    { "PREVIOUSSONG",              KEY_PREVIOUSSONG          },
+    { "PRINT",                     KEY_PRINT                 },
+    { "PRIVACY_SCREEN_TOGGLE",     KEY_PRIVACY_SCREEN_TOGGLE },
+    { "PROG1",                     KEY_PROG1                 },
+    { "PROG2",                     KEY_PROG2                 },
+    { "PROG3",                     KEY_PROG3                 },
+    { "PROG4",                     KEY_PROG4                 },
+    { "PROGRAM",                   KEY_PROGRAM               },
+    { "PROPS",                     KEY_PROPS                 },
+    { "PVR",                       KEY_PVR                   },
+    { "Q",                         KEY_Q                     },
+    { "QUESTION",                  KEY_QUESTION              },
+    { "R",                         KEY_R                     },
+    { "RADAR_OVERLAY",             KEY_RADAR_OVERLAY         },
+    { "RADIO",                     KEY_RADIO                 },
+    { "RECORD",                    KEY_RECORD                },
+    { "RED",                       KEY_RED                   },
+    { "REDO",                      KEY_REDO                  },
+    { "REFRESH",                   KEY_REFRESH               },
+    { "REFRESH_RATE_TOGGLE",       KEY_REFRESH_RATE_TOGGLE   },
+    { "REPLY",                     KEY_REPLY                 },
+    { "RESERVED",                  KEY_RESERVED              },
+    { "RESTART",                   KEY_RESTART               },
+    { "REWIND",                    KEY_REWIND                },
+    { "RFKILL",                    KEY_RFKILL                },
+    { "RIGHT",                     KEY_RIGHT                 },
+    { "RIGHT_DOWN",                KEY_RIGHT_DOWN            },
+    { "RIGHT_UP",                  KEY_RIGHT_UP              },
+    { "RIGHTALT",                  KEY_RIGHTALT              },
+    { "RIGHTBRACE",                KEY_RIGHTBRACE            },
+    { "RIGHTCTRL",                 KEY_RIGHTCTRL             },
+    { "RIGHTMETA",                 KEY_RIGHTMETA             },
+    { "RIGHTSHIFT",                KEY_RIGHTSHIFT            },
+    { "RO",                        KEY_RO                    },
+    { "ROOT_MENU",                 KEY_ROOT_MENU             },
+    { "ROTATE_DISPLAY",            KEY_ROTATE_DISPLAY        },
+    { "ROTATE_LOCK_TOGGLE",        KEY_ROTATE_LOCK_TOGGLE    },
+    { "S",                         KEY_S                     },
+    { "SAT",                       KEY_SAT                   },
+    { "SAT2",                      KEY_SAT2                  },
+    { "SAVE",                      KEY_SAVE                  },
+    { "SCALE",                     KEY_SCALE                 },
+    { "SCREEN",                    KEY_SCREEN                },
+    { "SCREENLOCK",                KEY_SCREENLOCK            },
+    { "SCREENSAVER",               KEY_SCREENSAVER           },
+    { "SCROLLDOWN",                KEY_SCROLLDOWN            },
+    { "SCROLLLOCK",                KEY_SCROLLLOCK            },
+    { "SCROLLUP",                  KEY_SCROLLUP              },
+    { "SEARCH",                    KEY_SEARCH                },
+    { "SELECT",                    KEY_SELECT                },
+    { "SELECTIVE_SCREENSHOT",      KEY_SELECTIVE_SCREENSHOT  },
+    { "SEMICOLON",                 KEY_SEMICOLON             },
+    { "SEND",                      KEY_SEND                  },
+    { "SENDFILE",                  KEY_SENDFILE              },
+    { "SETUP",                     KEY_SETUP                 },
+    { "SHOP",                      KEY_SHOP                  },
+    { "SHUFFLE",                   KEY_SHUFFLE               },
+    { "SIDEVU_SONAR",              KEY_SIDEVU_SONAR          },
+    { "SINGLE_RANGE_RADAR",        KEY_SINGLE_RANGE_RADAR    },
+    { "SLASH",                     KEY_SLASH                 },
+    { "SLEEP",                     KEY_SLEEP                 },
+    { "SLOW",                      KEY_SLOW                  },
+    { "SLOWREVERSE",               KEY_SLOWREVERSE           },
+    { "SOS",                       KEY_SOS                   },
+    { "SOUND",                     KEY_SOUND                 },
+    { "SPACE",                     KEY_SPACE                 },
+    { "SPELLCHECK",                KEY_SPELLCHECK            },
+    { "SPORT",                     KEY_SPORT                 },
+    { "SPREADSHEET",               KEY_SPREADSHEET           },
+    { "STOP",                      KEY_STOP                  },
+    { "STOP_RECORD",               KEY_STOP_RECORD           },
+    { "STOPCD",                    KEY_STOPCD                },
+    { "SUBTITLE",                  KEY_SUBTITLE              },
+    { "SUSPEND",                   KEY_SUSPEND               },
+    { "SWITCHVIDEOMODE",           KEY_SWITCHVIDEOMODE       },
+    { "SYSRQ",                     KEY_SYSRQ                 },
+    { "T",                         KEY_T                     },
+    { "TAB",                       KEY_TAB                   },
+    { "TAPE",                      KEY_TAPE                  },
+    { "TASKMANAGER",               KEY_TASKMANAGER           },
+    { "TEEN",                      KEY_TEEN                  },
+    { "TEXT",                      KEY_TEXT                  },
+    { "TIME",                      KEY_TIME                  },
+    { "TITLE",                     KEY_TITLE                 },
+    { "TOUCHPAD_OFF",              KEY_TOUCHPAD_OFF          },
+    { "TOUCHPAD_ON",               KEY_TOUCHPAD_ON           },
+    { "TOUCHPAD_TOGGLE",           KEY_TOUCHPAD_TOGGLE       },
+    { "TRADITIONAL_SONAR",         KEY_TRADITIONAL_SONAR     },
+    { "TUNER",                     KEY_TUNER                 },
+    { "TV",                        KEY_TV                    },
+    { "TV2",                       KEY_TV2                   },
+    { "TWEN",                      KEY_TWEN                  },
+    { "U",                         KEY_U                     },
+    { "UNDO",                      KEY_UNDO                  },
+    { "UNKNOWN",                   KEY_UNKNOWN               },
+    { "UNMUTE",                    KEY_UNMUTE                },
+    { "UP",                        KEY_UP                    },
+    { "UWB",                       KEY_UWB                   },
+    { "V",                         KEY_V                     },
+    { "VCR",                       KEY_VCR                   },
+    { "VCR2",                      KEY_VCR2                  },
+    { "VENDOR",                    KEY_VENDOR                },
+    { "VIDEO",                     KEY_VIDEO                 },
+    { "VIDEO_NEXT",                KEY_VIDEO_NEXT            },
+    { "VIDEO_PREV",                KEY_VIDEO_PREV            },
+    { "VIDEOPHONE",                KEY_VIDEOPHONE            },
+    { "VOD",                       KEY_VOD                   },
+    { "VOICECOMMAND",              KEY_VOICECOMMAND          },
+    { "VOICEMAIL",                 KEY_VOICEMAIL             },
+    { "VOLUMEDOWN",                KEY_VOLUMEDOWN            },
+    { "VOLUMEUP",                  KEY_VOLUMEUP              },
+    { "W",                         KEY_W                     },
+    { "WAKEUP",                    KEY_WAKEUP                },
+    { "WIMAX",                     KEY_WIMAX                 },
+    { "WLAN",                      KEY_WLAN                  },
+    { "WORDPROCESSOR",             KEY_WORDPROCESSOR         },
+    { "WPS_BUTTON",                KEY_WPS_BUTTON            },
+    { "WWAN",                      KEY_WWAN                  },
+    { "WWW",                       KEY_WWW                   },
+    { "X",                         KEY_X                     },
+    { "XFER",                      KEY_XFER                  },
+    { "Y",                         KEY_Y                     },
+    { "YELLOW",                    KEY_YELLOW                },
+    { "YEN",                       KEY_YEN                   },
+    { "Z",                         KEY_Z                     },
+    { "ZENKAKUHANKAKU",            KEY_ZENKAKUHANKAKU        },
+    { "ZOOM",                      KEY_ZOOM                  },
+    { "ZOOMIN",                    KEY_ZOOMIN                },
+    { "ZOOMOUT",                   KEY_ZOOMOUT               },
+    { "ZOOMRESET",                 KEY_ZOOMRESET             },
+};
+
+static const event_code_t REL_CODE[] = {
+    { "DIAL",                      REL_DIAL                  },
+    { "HWHEEL",                    REL_HWHEEL                },
+    { "HWHEEL_HI_RES",             REL_HWHEEL_HI_RES         },
+    { "MISC",                      REL_MISC                  },
+    { "RESERVED",                  REL_RESERVED              },
+    { "RX",                        REL_RX                    },
+    { "RY",                        REL_RY                    },
+    { "RZ",                        REL_RZ                    },
+    { "WHEEL",                     REL_WHEEL                 },
+    { "WHEEL_HI_RES",              REL_WHEEL_HI_RES          },
+    { "X",                         REL_X                     },
+    { "Y",                         REL_Y                     },
+    { "Z",                         REL_Z                     },
+};
+
+static const event_code_t ABS_CODE[] = {
+    { "BRAKE",                     ABS_BRAKE                 },
+    { "DISTANCE",                  ABS_DISTANCE              },
+    { "GAS",                       ABS_GAS                   },
+    { "HAT0X",                     ABS_HAT0X                 },
+    { "HAT0Y",                     ABS_HAT0Y                 },
+    { "HAT1X",                     ABS_HAT1X                 },
+    { "HAT1Y",                     ABS_HAT1Y                 },
+    { "HAT2X",                     ABS_HAT2X                 },
+    { "HAT2Y",                     ABS_HAT2Y                 },
+    { "HAT3X",                     ABS_HAT3X                 },
+    { "HAT3Y",                     ABS_HAT3Y                 },
+    { "MISC",                      ABS_MISC                  },
+    { "MT_BLOB_ID",                ABS_MT_BLOB_ID            },
+    { "MT_DISTANCE",               ABS_MT_DISTANCE           },
+    { "MT_ORIENTATION",            ABS_MT_ORIENTATION        },
+    { "MT_POSITION_X",             ABS_MT_POSITION_X         },
+    { "MT_POSITION_Y",             ABS_MT_POSITION_Y         },
+    { "MT_PRESSURE",               ABS_MT_PRESSURE           },
+    { "MT_SLOT",                   ABS_MT_SLOT               },
+    { "MT_TOOL_TYPE",              ABS_MT_TOOL_TYPE          },
+    { "MT_TOOL_X",                 ABS_MT_TOOL_X             },
+    { "MT_TOOL_Y",                 ABS_MT_TOOL_Y             },
+    { "MT_TOUCH_MAJOR",            ABS_MT_TOUCH_MAJOR        },
+    { "MT_TOUCH_MINOR",            ABS_MT_TOUCH_MINOR        },
+    { "MT_TRACKING_ID",            ABS_MT_TRACKING_ID        },
+    { "MT_WIDTH_MAJOR",            ABS_MT_WIDTH_MAJOR        },
+    { "MT_WIDTH_MINOR",            ABS_MT_WIDTH_MINOR        },
+    { "PRESSURE",                  ABS_PRESSURE              },
+    { "PROFILE",                   ABS_PROFILE               },
+    { "RESERVED",                  ABS_RESERVED              },
+    { "RUDDER",                    ABS_RUDDER                },
+    { "RX",                        ABS_RX                    },
+    { "RY",                        ABS_RY                    },
+    { "RZ",                        ABS_RZ                    },
+    { "THROTTLE",                  ABS_THROTTLE              },
+    { "TILT_X",                    ABS_TILT_X                },
+    { "TILT_Y",                    ABS_TILT_Y                },
+    { "TOOL_WIDTH",                ABS_TOOL_WIDTH            },
+    { "VOLUME",                    ABS_VOLUME                },
+    { "WHEEL",                     ABS_WHEEL                 },
+    { "X",                         ABS_X                     },
+    { "Y",                         ABS_Y                     },
+    { "Z",                         ABS_Z                     },
+};
+
+static const event_code_t SW_CODE[] = {
+    { "CAMERA_LENS_COVER",         SW_CAMERA_LENS_COVER      },
+    { "DOCK",                      SW_DOCK                   },
+    { "FRONT_PROXIMITY",           SW_FRONT_PROXIMITY        },
+    { "HEADPHONE_INSERT",          SW_HEADPHONE_INSERT       },
+    { "JACK_PHYSICAL_INSERT",      SW_JACK_PHYSICAL_INSERT   },
+    { "KEYPAD_SLIDE",              SW_KEYPAD_SLIDE           },
+    { "LID",                       SW_LID                    },
+    { "LINEIN_INSERT",             SW_LINEIN_INSERT          },
+    { "LINEOUT_INSERT",            SW_LINEOUT_INSERT         },
+    { "MACHINE_COVER",             SW_MACHINE_COVER          },
+    { "MICROPHONE_INSERT",         SW_MICROPHONE_INSERT      },
+    { "MUTE_DEVICE",               SW_MUTE_DEVICE            },
+    { "PEN_INSERTED",              SW_PEN_INSERTED           },
+    { "RADIO",                     SW_RADIO                  },
+    { "RFKILL_ALL",                SW_RFKILL_ALL             },
+    { "ROTATE_LOCK",               SW_ROTATE_LOCK            },
+    { "TABLET_MODE",               SW_TABLET_MODE            },
+    { "VIDEOOUT_INSERT",           SW_VIDEOOUT_INSERT        },
 };
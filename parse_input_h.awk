@@ -1,31 +1,81 @@
+# not every includer needs every table, e.g. input-event-loadgen.c
 BEGIN {
 	print("#include <linux/input.h>");
+	print("\ntypedef struct event_code {");
+	print("    const char      *name;");
+	print("    unsigned short  code;");
+	print("} event_code_t;");
 }
-/Keys and buttons/ { 
-	print("\nstatic const char *KEY_NAME[KEY_CNT] = {"); 
+/Keys and buttons/ {
+	print("\nstatic const char *KEY_NAME[KEY_CNT] __attribute__((unused)) = {");
+	table="KEY";
 	next;
 }
 
-/Switch events/ { 
-	print("\nstatic const char *SW_NAME[SW_CNT] = {"); 
+/Relative axes/ {
+	print("\nstatic const char *REL_NAME[REL_CNT] __attribute__((unused)) = {");
+	table="REL";
 	next;
 }
 
-/#define (SW|BTN|KEY)_\w/ {
-	if($2 ~ /(KEY|SW)_(MIN_INTERESTING|MAX)/) {
+/Absolute axes/ {
+	print("\nstatic const char *ABS_NAME[ABS_CNT] __attribute__((unused)) = {");
+	table="ABS";
+	next;
+}
+
+/Switch events/ {
+	print("\nstatic const char *SW_NAME[SW_CNT] __attribute__((unused)) = {");
+	table="SW";
+	next;
+}
+
+/#define (SW|BTN|KEY|REL|ABS)_[A-Za-z0-9_]/ {
+	if($2 ~ /^(KEY|SW|REL|ABS)_(MIN_INTERESTING|MAX)$/) {
 		next;
-	} else if($2 ~ /(KEY|SW)_CNT/) {
+	} else if($2 ~ /^(KEY|SW|REL|ABS)_CNT$/) {
 		print("};");
 		next;
-	}	
+	}
 
-	if(substr($2, 0, 3) ~ /(KEY|SW)/) {
-		name=substr($2, index($2, "_")+1); 
+	if(substr($2, 0, 3) ~ /(KEY|SW|REL|ABS)/) {
+		name=substr($2, index($2, "_")+1);
 	} else {
 		name=$2;
 	}
 
 	printf("%4s[%-25s] = \"%s\",\n", "", $2, name);
+
+	n[table]++;
+	names[table, n[table]]=name;
+	defines[table, n[table]]=$2;
 }
 
+# name -> code, sorted for bsearch() with strcasecmp()
+function print_codes(table,    i, j, key, name, define) {
+	for(i=2; i <= n[table]; i++) {
+		name=names[table, i];
+		define=defines[table, i];
+		key=tolower(name);
+		for(j=i-1; j > 0 && tolower(names[table, j]) > key; j--) {
+			names[table, j+1]=names[table, j];
+			defines[table, j+1]=defines[table, j];
+		}
+		names[table, j+1]=name;
+		defines[table, j+1]=define;
+	}
+
+	printf("\nstatic const event_code_t %s_CODE[] = {\n", table);
+	for(i=1; i <= n[table]; i++) {
+		printf("%4s{ %-28s %-25s },\n", "",
+			"\"" names[table, i] "\",", defines[table, i]);
+	}
+	print("};");
+}
 
+END {
+	print_codes("KEY");
+	print_codes("REL");
+	print_codes("ABS");
+	print_codes("SW");
+}